@@ -0,0 +1,125 @@
+/*
+ * Copyright 2015-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ASTAR_OPEN_LIST_H
+#define ASTAR_OPEN_LIST_H
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "astar_search/astar_util.h"
+
+// Open list of hybrid astar
+// Nodes are identified by their index in the node arena of AstarSearch
+class OpenListInterface
+{
+public:
+  virtual ~OpenListInterface() = default;
+
+  virtual bool empty() const = 0;
+
+  // Push a node, or update its cost if the node is already in the list
+  virtual void push(const SimpleNode& sn, size_t id) = 0;
+
+  // Pop the minimum cost node
+  virtual SimpleNode pop() = 0;
+
+  virtual void clear() = 0;
+};
+
+// std::priority_queue without decrease-key
+// An updated node is pushed again and its old entry is popped later as well
+class OpenListPriorityQueue : public OpenListInterface
+{
+public:
+  bool empty() const override;
+  void push(const SimpleNode& sn, size_t id) override;
+  SimpleNode pop() override;
+  void clear() override;
+
+private:
+  std::priority_queue<SimpleNode, std::vector<SimpleNode>, std::greater<SimpleNode>> queue_;
+};
+
+// Binary heap with decrease-key, every node is in the list at most once
+class OpenListIndexedHeap : public OpenListInterface
+{
+public:
+  bool empty() const override;
+  void push(const SimpleNode& sn, size_t id) override;
+  SimpleNode pop() override;
+  void clear() override;
+
+private:
+  struct Entry
+  {
+    SimpleNode node;
+    size_t id;
+  };
+
+  void siftUp(size_t pos);
+  void siftDown(size_t pos);
+  void place(const Entry& entry, size_t pos);
+
+  std::vector<Entry> heap_;
+  std::vector<int> position_;  // position in heap_ for each node id, -1 if not in the list
+};
+
+// Two-level bucket queue keyed on quantized cost
+// Coarse buckets are unsorted, only the lowest one is spread into fine buckets (small heaps).
+// An updated node invalidates its old entry, which is dropped when it reaches the top.
+class OpenListBucket : public OpenListInterface
+{
+public:
+  // bucket_width: cost range of a fine bucket, fine_size: fine buckets in a coarse bucket
+  explicit OpenListBucket(double bucket_width, int fine_size = 64);
+
+  bool empty() const override;
+  void push(const SimpleNode& sn, size_t id) override;
+  SimpleNode pop() override;
+  void clear() override;
+
+private:
+  struct Entry
+  {
+    SimpleNode node;
+    size_t id;
+
+    bool operator>(const Entry& right) const
+    {
+      return node.cost > right.node.cost;
+    }
+  };
+
+  int coarseIndex(double cost) const;
+  int fineIndex(double cost) const;
+  void spread(int coarse_index);
+  void gather();
+
+  double bucket_width_;
+  int fine_size_;
+
+  std::vector<std::vector<Entry>> coarse_;
+  std::vector<std::vector<Entry>> fine_;  // heaps for current_coarse_
+  int current_coarse_;                    // coarse bucket spread in fine_, -1 if none
+  int current_fine_;                      // lowest fine bucket that may be non-empty
+
+  std::vector<double> cost_;  // cost of the valid entry for each node id, negative if not in the list
+  size_t size_;               // number of valid entries
+};
+
+#endif
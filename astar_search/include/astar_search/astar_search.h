@@ -17,7 +17,10 @@
 #ifndef ASTER_PLANNER_H
 #define ASTER_PLANNER_H
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <vector>
 #include <queue>
 #include <string>
@@ -29,7 +32,9 @@
 #include <geometry_msgs/PoseArray.h>
 #include <nav_msgs/Path.h>
 
+#include "astar_search/astar_open_list.h"
 #include "astar_search/astar_util.h"
+#include "astar_search/reeds_shepp.h"
 
 class AstarSearch
 {
@@ -49,9 +54,12 @@ public:
 
 private:
   void createStateUpdateTable();
+  void createFootprintTable();
   bool search();
   void poseToIndex(const geometry_msgs::Pose& pose, int* index_x, int* index_y, int* index_theta);
+  void xytToIndex(double x, double y, double theta, int* index_x, int* index_y, int* index_theta);
   void pointToIndex(const geometry_msgs::Point& point, int* index_x, int* index_y);
+  void pointToIndex(double x, double y, int* index_x, int* index_y);
   bool isOutOfRange(int index_x, int index_y);
   void setPath(const SimpleNode& goal);
   bool setStartNode(const geometry_msgs::Pose& start_pose);
@@ -59,8 +67,18 @@ private:
   bool isGoal(double x, double y, double theta);
   bool isObs(int index_x, int index_y);
   bool detectCollision(const SimpleNode& sn);
+  bool detectCollisionDistanceTransform(const SimpleNode& sn, const FootprintMask& mask);
+  void calcDistanceTransform();
+  bool tryAnalyticExpansion(const SimpleNode& sn);
   bool calcWaveFrontHeuristic(const SimpleNode& sn);
   bool detectCollisionWaveFront(const WaveFrontNode& sn);
+  size_t getNodeIndex(int index_x, int index_y, int index_theta);
+  AstarNode& getNode(int index_x, int index_y, int index_theta);
+  double getCellCost(int index_x, int index_y);
+  bool isCellVisited(int index_x, int index_y);
+  void setCellCost(int index_x, int index_y, double hc);
+  void invalidateNodes();
+  void updateCell(size_t og_index);
 
   // ros param
   ros::NodeHandle n_;
@@ -69,7 +87,11 @@ private:
   bool use_back_;                 // backward search
   bool use_potential_heuristic_;  // potential cost function
   bool use_wavefront_heuristic_;  // wavefront cost function
+  bool use_distance_transform_;   // collision check by distance to obstacles
   double time_limit_;             // planning time limit [msec]
+  std::string open_list_type_;    // priority_queue, indexed_heap or bucket
+  bool use_analytic_expansion_;   // shoot reeds-shepp (dubins without backward) curve to the goal
+  int analytic_expansion_interval_;  // try analytic expansion every this number of expansions [-]
 
   // robot configs (TODO: obtain from vehicle_info)
   double robot_length_;           // X [m]
@@ -92,17 +114,29 @@ private:
 
   // hybrid astar variables
   std::vector<std::vector<NodeUpdate>> state_update_table_;
-  std::vector<std::vector<std::vector<AstarNode>>> nodes_;
-  std::priority_queue<SimpleNode, std::vector<SimpleNode>, std::greater<SimpleNode>> openlist_;
+  std::vector<FootprintMask> footprint_table_;  // robot footprint for each theta index
+  double footprint_resolution_;                 // costmap resolution footprint_table_ is made for
+  double inscribed_radius_;                     // radius of inscribed circle of the robot [cell]
+  double circumscribed_radius_;                 // radius of circumscribed circle of the robot [cell]
+  std::vector<AstarNode> nodes_;  // flat [y][x][theta] arena
+  std::vector<AstarCell> cells_;  // flat [y][x] costmap layer
+  uint32_t generation_;           // nodes and cells stamped with another generation are unvisited
+  std::unique_ptr<OpenListInterface> openlist_;
   std::vector<SimpleNode> goallist_;
+  int expansion_count_;  // expanded nodes in the last search
 
   // costmap as occupancy grid
   nav_msgs::OccupancyGrid costmap_;
 
+  // costmap origin as 2D transform
+  double origin_x_, origin_y_, origin_yaw_;
+  double origin_cos_, origin_sin_;
+
   // pose in costmap frame
   geometry_msgs::PoseStamped start_pose_local_;
   geometry_msgs::PoseStamped goal_pose_local_;
   double goal_yaw_;
+  double goal_cos_, goal_sin_;
 
   // result path
   nav_msgs::Path path_;
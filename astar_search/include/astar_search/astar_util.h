@@ -17,6 +17,8 @@
 #ifndef ASTAR_UTIL_H
 #define ASTAR_UTIL_H
 
+#include <vector>
+
 #include <tf/tf.h>
 
 enum class STATUS : uint8_t
@@ -36,6 +38,17 @@ struct AstarNode
   double move_distance = 0;      // actual move distance
   bool back;                     // true if the current direction of the vehicle is back
   AstarNode* parent = NULL;      // parent node
+  uint32_t generation = 0;       // search generation in which this node was last touched
+};
+
+// Costmap information shared by every heading of a grid cell
+struct AstarCell
+{
+  bool obstacle = false;     // obstacle or unknown area
+  double potential = 0;      // potential cost from the costmap
+  double hc = 0;             // heuristic cost written during the search (wavefront)
+  uint32_t generation = 0;   // hc is valid only in the generation it was written
+  double obstacle_distance = 0;  // distance to the closest obstacle cell [cell]
 };
 
 struct WaveFrontNode
@@ -48,6 +61,14 @@ struct WaveFrontNode
   WaveFrontNode(int x, int y, double cost);
 };
 
+// Cells covered by the robot footprint at one discretized heading
+struct FootprintMask
+{
+  std::vector<std::pair<int, int>> offsets;  // (x, y) cell offsets from base_link
+  int min_x = 0, min_y = 0, max_x = 0, max_y = 0;  // bounding box of offsets
+  double center_x = 0, center_y = 0;               // center of the rectangle from base_link [cell]
+};
+
 struct NodeUpdate
 {
   double shift_x;
@@ -136,6 +157,13 @@ inline double calcDiffOfRadian(double a, double b)
     return 2.0 * M_PI - diff;
 }
 
+inline bool isSamePose(const geometry_msgs::Pose& a, const geometry_msgs::Pose& b)
+{
+  return a.position.x == b.position.x && a.position.y == b.position.y && a.position.z == b.position.z &&
+         a.orientation.x == b.orientation.x && a.orientation.y == b.orientation.y &&
+         a.orientation.z == b.orientation.z && a.orientation.w == b.orientation.w;
+}
+
 inline geometry_msgs::Pose xytToPoseMsg(double x, double y, double theta)
 {
   geometry_msgs::Pose p;
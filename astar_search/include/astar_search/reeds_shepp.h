@@ -0,0 +1,59 @@
+/*
+ * Copyright 2015-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REEDS_SHEPP_H
+#define REEDS_SHEPP_H
+
+#include <array>
+#include <cstdint>
+
+// Shortest paths of a car with minimum turning radius, used for analytic expansion of hybrid astar
+// Based on J. A. Reeds and L. A. Shepp, "Optimal paths for a car that goes both forwards and backwards" (1990)
+// and L. E. Dubins, "On curves of minimal length with a constraint on average curvature" (1957)
+
+enum class SegmentType : uint8_t
+{
+  NOP,
+  LEFT,
+  STRAIGHT,
+  RIGHT
+};
+
+struct AnalyticPath
+{
+  std::array<SegmentType, 5> type;
+  std::array<double, 5> length;  // normalized by turning radius, negative for backward
+
+  AnalyticPath();
+  AnalyticPath(const std::array<SegmentType, 5>& path_type, double t, double u, double v, double w = 0.0,
+               double x = 0.0);
+
+  // total length normalized by turning radius
+  double totalLength() const;
+};
+
+// Shortest path going forward and backward, from (x1, y1, theta1) to (x2, y2, theta2)
+AnalyticPath calcReedsSheppPath(double x1, double y1, double theta1, double x2, double y2, double theta2,
+                                double radius);
+
+// Shortest path going forward only, from (x1, y1, theta1) to (x2, y2, theta2)
+AnalyticPath calcDubinsPath(double x1, double y1, double theta1, double x2, double y2, double theta2, double radius);
+
+// Pose after moving distance [m] along the path from (x0, y0, theta0), back is true while moving backward
+void interpolateAnalyticPath(const AnalyticPath& path, double x0, double y0, double theta0, double radius,
+                             double distance, double* x, double* y, double* theta, bool* back);
+
+#endif
@@ -0,0 +1,311 @@
+/*
+ * Copyright 2015-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "astar_search/astar_open_list.h"
+
+bool OpenListPriorityQueue::empty() const
+{
+  return queue_.empty();
+}
+
+void OpenListPriorityQueue::push(const SimpleNode& sn, size_t /*id*/)
+{
+  queue_.push(sn);
+}
+
+SimpleNode OpenListPriorityQueue::pop()
+{
+  SimpleNode top = queue_.top();
+  queue_.pop();
+  return top;
+}
+
+void OpenListPriorityQueue::clear()
+{
+  std::priority_queue<SimpleNode, std::vector<SimpleNode>, std::greater<SimpleNode>> empty;
+  std::swap(queue_, empty);
+}
+
+bool OpenListIndexedHeap::empty() const
+{
+  return heap_.empty();
+}
+
+void OpenListIndexedHeap::push(const SimpleNode& sn, size_t id)
+{
+  if (id >= position_.size())
+  {
+    position_.resize(id + 1, -1);
+  }
+
+  // New node
+  if (position_[id] < 0)
+  {
+    heap_.push_back({ sn, id });
+    position_[id] = heap_.size() - 1;
+    siftUp(heap_.size() - 1);
+    return;
+  }
+
+  // Update cost of the node in the list
+  size_t pos = position_[id];
+  bool decreased = sn.cost < heap_[pos].node.cost;
+  heap_[pos].node = sn;
+  if (decreased)
+  {
+    siftUp(pos);
+  }
+  else
+  {
+    siftDown(pos);
+  }
+}
+
+SimpleNode OpenListIndexedHeap::pop()
+{
+  SimpleNode top = heap_.front().node;
+  position_[heap_.front().id] = -1;
+
+  // Move the last entry to the root
+  Entry last = heap_.back();
+  heap_.pop_back();
+  if (!heap_.empty())
+  {
+    place(last, 0);
+    siftDown(0);
+  }
+
+  return top;
+}
+
+void OpenListIndexedHeap::clear()
+{
+  // Popped nodes are already -1, only the remaining ones are reset
+  for (const auto& entry : heap_)
+  {
+    position_[entry.id] = -1;
+  }
+  heap_.clear();
+}
+
+void OpenListIndexedHeap::place(const Entry& entry, size_t pos)
+{
+  heap_[pos] = entry;
+  position_[entry.id] = pos;
+}
+
+void OpenListIndexedHeap::siftUp(size_t pos)
+{
+  Entry entry = heap_[pos];
+  while (pos > 0)
+  {
+    size_t parent = (pos - 1) / 2;
+    if (!(heap_[parent].node > entry.node))
+    {
+      break;
+    }
+    place(heap_[parent], pos);
+    pos = parent;
+  }
+  place(entry, pos);
+}
+
+void OpenListIndexedHeap::siftDown(size_t pos)
+{
+  Entry entry = heap_[pos];
+  size_t size = heap_.size();
+  while (true)
+  {
+    size_t child = 2 * pos + 1;
+    if (child >= size)
+    {
+      break;
+    }
+    if (child + 1 < size && heap_[child].node > heap_[child + 1].node)
+    {
+      child++;
+    }
+    if (!(entry.node > heap_[child].node))
+    {
+      break;
+    }
+    place(heap_[child], pos);
+    pos = child;
+  }
+  place(entry, pos);
+}
+
+OpenListBucket::OpenListBucket(double bucket_width, int fine_size)
+  : bucket_width_(bucket_width), fine_size_(fine_size), fine_(fine_size), current_coarse_(-1), current_fine_(0),
+    size_(0)
+{
+}
+
+bool OpenListBucket::empty() const
+{
+  return size_ == 0;
+}
+
+int OpenListBucket::coarseIndex(double cost) const
+{
+  return static_cast<int>(cost / (bucket_width_ * fine_size_));
+}
+
+int OpenListBucket::fineIndex(double cost) const
+{
+  int index = static_cast<int>(cost / bucket_width_) - coarseIndex(cost) * fine_size_;
+
+  // Guard against rounding errors at bucket boundaries
+  return std::min(std::max(index, 0), fine_size_ - 1);
+}
+
+void OpenListBucket::push(const SimpleNode& sn, size_t id)
+{
+  if (id >= cost_.size())
+  {
+    cost_.resize(id + 1, -1.0);
+  }
+
+  // The previous entry of this node becomes invalid
+  if (cost_[id] < 0)
+  {
+    size_++;
+  }
+  cost_[id] = sn.cost;
+
+  Entry entry = { sn, id };
+  int coarse_index = coarseIndex(sn.cost);
+
+  // Lower than the current bucket, which happens with inconsistent heuristics
+  if (current_coarse_ >= 0 && coarse_index < current_coarse_)
+  {
+    gather();
+  }
+
+  if (coarse_index == current_coarse_)
+  {
+    int fine_index = fineIndex(sn.cost);
+    fine_[fine_index].push_back(entry);
+    std::push_heap(fine_[fine_index].begin(), fine_[fine_index].end(), std::greater<Entry>());
+    current_fine_ = std::min(current_fine_, fine_index);
+    return;
+  }
+
+  if (coarse_index >= static_cast<int>(coarse_.size()))
+  {
+    coarse_.resize(coarse_index + 1);
+  }
+  coarse_[coarse_index].push_back(entry);
+}
+
+SimpleNode OpenListBucket::pop()
+{
+  while (true)
+  {
+    // Lowest non-empty fine bucket
+    while (current_coarse_ >= 0 && current_fine_ < fine_size_ && fine_[current_fine_].empty())
+    {
+      current_fine_++;
+    }
+
+    // Fine buckets are exhausted, spread the next non-empty coarse bucket
+    if (current_coarse_ < 0 || current_fine_ == fine_size_)
+    {
+      int next = current_coarse_ + 1;
+      while (coarse_[next].empty())
+      {
+        next++;
+      }
+      spread(next);
+      continue;
+    }
+
+    std::vector<Entry>& bucket = fine_[current_fine_];
+    std::pop_heap(bucket.begin(), bucket.end(), std::greater<Entry>());
+    Entry top = bucket.back();
+    bucket.pop_back();
+
+    // Skip entries replaced by a later push
+    if (cost_[top.id] != top.node.cost)
+    {
+      continue;
+    }
+
+    cost_[top.id] = -1.0;
+    size_--;
+    return top.node;
+  }
+}
+
+void OpenListBucket::clear()
+{
+  for (auto& bucket : coarse_)
+  {
+    for (const auto& entry : bucket)
+    {
+      cost_[entry.id] = -1.0;
+    }
+    bucket.clear();
+  }
+  for (auto& bucket : fine_)
+  {
+    for (const auto& entry : bucket)
+    {
+      cost_[entry.id] = -1.0;
+    }
+    bucket.clear();
+  }
+
+  current_coarse_ = -1;
+  current_fine_ = 0;
+  size_ = 0;
+}
+
+// Distribute the coarse bucket into fine buckets
+void OpenListBucket::spread(int coarse_index)
+{
+  for (const auto& entry : coarse_[coarse_index])
+  {
+    int fine_index = fineIndex(entry.node.cost);
+    fine_[fine_index].push_back(entry);
+  }
+  coarse_[coarse_index].clear();
+
+  for (auto& bucket : fine_)
+  {
+    std::make_heap(bucket.begin(), bucket.end(), std::greater<Entry>());
+  }
+
+  current_coarse_ = coarse_index;
+  current_fine_ = 0;
+}
+
+// Move the fine buckets back into their coarse bucket
+void OpenListBucket::gather()
+{
+  for (auto& bucket : fine_)
+  {
+    coarse_[current_coarse_].insert(coarse_[current_coarse_].end(), bucket.begin(), bucket.end());
+    bucket.clear();
+  }
+
+  current_coarse_ = -1;
+  current_fine_ = 0;
+}
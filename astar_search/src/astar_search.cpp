@@ -16,7 +16,67 @@
 
 #include "astar_search/astar_search.h"
 
+namespace
+{
+// 1D squared euclidean distance transform (Felzenszwalb and Huttenlocher)
+// f: squared distance to obstacle along the other axis, step: stride of elements in f
+void distanceTransform1D(std::vector<double>& f, int offset, int size, int step, std::vector<double>& d,
+                         std::vector<int>& v, std::vector<double>& z)
+{
+  // lower envelope of parabolas rooted at each element
+  int k = 0;
+  v[0] = 0;
+  z[0] = -std::numeric_limits<double>::infinity();
+  z[1] = std::numeric_limits<double>::infinity();
+  for (int q = 1; q < size; q++)
+  {
+    double fq = f[offset + q * step];
+    double s;
+    while (true)
+    {
+      double fv = f[offset + v[k] * step];
+      s = ((fq + q * q) - (fv + v[k] * v[k])) / (2.0 * q - 2.0 * v[k]);
+      if (s > z[k] || k == 0)
+      {
+        break;
+      }
+      k--;
+    }
+
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = std::numeric_limits<double>::infinity();
+  }
+
+  k = 0;
+  for (int q = 0; q < size; q++)
+  {
+    while (z[k + 1] < q)
+    {
+      k++;
+    }
+    d[q] = (q - v[k]) * (q - v[k]) + f[offset + v[k] * step];
+  }
+
+  for (int q = 0; q < size; q++)
+  {
+    f[offset + q * step] = d[q];
+  }
+}
+}  // namespace
+
 AstarSearch::AstarSearch()
+  : footprint_resolution_(0)
+  , inscribed_radius_(0)
+  , circumscribed_radius_(0)
+  , generation_(1)
+  , expansion_count_(0)
+  , origin_x_(0)
+  , origin_y_(0)
+  , origin_yaw_(0)
+  , origin_cos_(1)
+  , origin_sin_(0)
 {
   ros::NodeHandle private_nh_("~");
 
@@ -24,7 +84,12 @@ AstarSearch::AstarSearch()
   private_nh_.param<bool>("use_back", use_back_, true);
   private_nh_.param<bool>("use_potential_heuristic", use_potential_heuristic_, true);
   private_nh_.param<bool>("use_wavefront_heuristic", use_wavefront_heuristic_, false);
+  private_nh_.param<bool>("use_distance_transform", use_distance_transform_, false);
   private_nh_.param<double>("time_limit", time_limit_, 5000.0);
+  private_nh_.param<std::string>("open_list_type", open_list_type_, "priority_queue");
+  private_nh_.param<bool>("use_analytic_expansion", use_analytic_expansion_, false);
+  private_nh_.param<int>("analytic_expansion_interval", analytic_expansion_interval_, 10);
+  analytic_expansion_interval_ = std::max(analytic_expansion_interval_, 1);
 
   // robot configs
   private_nh_.param<double>("robot_length", robot_length_, 4.5);
@@ -46,6 +111,20 @@ AstarSearch::AstarSearch()
   private_nh_.param<double>("distance_heuristic_weight", distance_heuristic_weight_, 1.0);
 
   createStateUpdateTable();
+
+  // open list, bucket width is the minimum moving cost with one state update
+  if (open_list_type_ == "indexed_heap")
+  {
+    openlist_.reset(new OpenListIndexedHeap());
+  }
+  else if (open_list_type_ == "bucket")
+  {
+    openlist_.reset(new OpenListBucket(minimum_turning_radius_ * 2.0 * M_PI / theta_size_));
+  }
+  else
+  {
+    openlist_.reset(new OpenListPriorityQueue());
+  }
 }
 
 AstarSearch::~AstarSearch()
@@ -142,55 +221,253 @@ void AstarSearch::createStateUpdateTable()
   }
 }
 
-void AstarSearch::initialize(const nav_msgs::OccupancyGrid& costmap)
+// robot footprint cells for each angle, used for collision detection
+void AstarSearch::createFootprintTable()
 {
-  costmap_ = costmap;
+  // Define the robot as rectangle
+  double left = -1.0 * robot_base2back_;
+  double right = robot_length_ - robot_base2back_;
+  double top = robot_width_ / 2.0;
+  double bottom = -1.0 * robot_width_ / 2.0;
+  double resolution = costmap_.info.resolution;
+  double one_angle_range = 2.0 * M_PI / theta_size_;
+
+  footprint_table_.assign(theta_size_, FootprintMask());
+
+  for (int i = 0; i < theta_size_; i++)
+  {
+    double theta = i * one_angle_range;
+    double cos_theta = std::cos(theta);
+    double sin_theta = std::sin(theta);
+
+    // Rasterize the rotated rectangle around base_link
+    // (small epsilon absorbs rounding errors of cos/sin, e.g. cos(M_PI_2) is not exactly 0)
+    static const double epsilon = 1e-6;
+    FootprintMask& mask = footprint_table_[i];
+    for (double x = left; x < right; x += resolution)
+    {
+      for (double y = top; y > bottom; y -= resolution)
+      {
+        int offset_x = std::floor((x * cos_theta - y * sin_theta) / resolution + epsilon);
+        int offset_y = std::floor((x * sin_theta + y * cos_theta) / resolution + epsilon);
+        mask.offsets.emplace_back(offset_x, offset_y);
+      }
+    }
+
+    // Neighboring sample points often fall into the same cell
+    std::sort(mask.offsets.begin(), mask.offsets.end());
+    mask.offsets.erase(std::unique(mask.offsets.begin(), mask.offsets.end()), mask.offsets.end());
 
+    for (const auto& offset : mask.offsets)
+    {
+      mask.min_x = std::min(mask.min_x, offset.first);
+      mask.min_y = std::min(mask.min_y, offset.second);
+      mask.max_x = std::max(mask.max_x, offset.first);
+      mask.max_y = std::max(mask.max_y, offset.second);
+    }
+
+    // Center of the rectangle, used for the distance transform check
+    double center = (left + right) / 2.0;
+    mask.center_x = center * cos_theta / resolution;
+    mask.center_y = center * sin_theta / resolution;
+  }
+
+  inscribed_radius_ = robot_width_ / 2.0 / resolution;
+  circumscribed_radius_ = std::hypot(robot_length_ / 2.0, robot_width_ / 2.0) / resolution;
+  footprint_resolution_ = resolution;
+}
+
+// Euclidean distance from each cell to the closest obstacle cell
+void AstarSearch::calcDistanceTransform()
+{
   int height = costmap_.info.height;
   int width = costmap_.info.width;
 
-  // size initialization
-  nodes_.resize(height);
-  for (int i = 0; i < height; i++)
+  // squared distance, 0 on obstacles
+  // (large finite value instead of infinity to keep the parabola intersection well-defined)
+  static const double far = 1e20;
+  std::vector<double> f(height * width);
+  for (int i = 0; i < height * width; i++)
+  {
+    f[i] = cells_[i].obstacle ? 0.0 : far;
+  }
+
+  // work buffers shared by every row and column
+  int size = std::max(height, width);
+  std::vector<double> d(size);
+  std::vector<int> v(size);
+  std::vector<double> z(size + 1);
+
+  // columns, then rows
+  for (int j = 0; j < width; j++)
   {
-    nodes_[i].resize(width);
+    distanceTransform1D(f, j, height, width, d, v, z);
   }
   for (int i = 0; i < height; i++)
   {
-    for (int j = 0; j < width; j++)
+    distanceTransform1D(f, i * width, width, 1, d, v, z);
+  }
+
+  for (int i = 0; i < height * width; i++)
+  {
+    cells_[i].obstacle_distance = std::sqrt(f[i]);
+  }
+}
+
+void AstarSearch::initialize(const nav_msgs::OccupancyGrid& costmap)
+{
+  // Grids of the same geometry are updated only where the cost has changed
+  bool same_geometry = !cells_.empty() && costmap.info.width == costmap_.info.width &&
+                       costmap.info.height == costmap_.info.height &&
+                       costmap.info.resolution == costmap_.info.resolution &&
+                       isSamePose(costmap.info.origin, costmap_.info.origin) &&
+                       costmap.data.size() == costmap_.data.size();
+
+  costmap_.header = costmap.header;
+  costmap_.info = costmap.info;
+
+  // costmap origin as 2D transform
+  origin_x_ = costmap_.info.origin.position.x;
+  origin_y_ = costmap_.info.origin.position.y;
+  origin_yaw_ = tf::getYaw(costmap_.info.origin.orientation);
+  origin_cos_ = std::cos(origin_yaw_);
+  origin_sin_ = std::sin(origin_yaw_);
+
+  // nodes left over from the previous search are invalidated by the generation
+  invalidateNodes();
+
+  if (same_geometry)
+  {
+    bool obstacle_changed = false;
+    for (size_t og_index = 0; og_index < costmap.data.size(); og_index++)
     {
-      nodes_[i][j].resize(theta_size_);
+      if (costmap.data[og_index] != costmap_.data[og_index])
+      {
+        bool obstacle = cells_[og_index].obstacle;
+        costmap_.data[og_index] = costmap.data[og_index];
+        updateCell(og_index);
+        obstacle_changed = obstacle_changed || (obstacle != cells_[og_index].obstacle);
+      }
     }
+
+    if (use_distance_transform_ && obstacle_changed)
+    {
+      calcDistanceTransform();
+    }
+    return;
+  }
+
+  costmap_.data = costmap.data;
+
+  int height = costmap_.info.height;
+  int width = costmap_.info.width;
+
+  // size initialization
+  nodes_.resize(height * width * theta_size_);
+  cells_.assign(height * width, AstarCell());
+
+  // footprint depends on the grid resolution
+  if (footprint_resolution_ != costmap_.info.resolution)
+  {
+    createFootprintTable();
   }
 
   // cost initialization
-  for (int i = 0; i < height; i++)
+  for (int og_index = 0; og_index < height * width; og_index++)
   {
-    for (int j = 0; j < width; j++)
-    {
-      // Index of subscribing OccupancyGrid message
-      int og_index = i * width + j;
-      int cost = costmap_.data[og_index];
+    updateCell(og_index);
+  }
 
-      // hc is set to be 0 when reset()
-      if (cost == 0)
-      {
-        continue;
-      }
+  if (use_distance_transform_)
+  {
+    calcDistanceTransform();
+  }
+}
 
-      // obstacle or unknown area
-      if (cost < 0 || obstacle_threshold_ <= cost)
-      {
-        nodes_[i][j][0].status = STATUS::OBS;
-      }
+// Update the cell from the cost of subscribing OccupancyGrid message
+void AstarSearch::updateCell(size_t og_index)
+{
+  int cost = costmap_.data[og_index];
+  AstarCell& cell = cells_[og_index];
 
-      // the cost more than threshold is regarded almost same as an obstacle
-      // because of its very high cost
-      if (use_potential_heuristic_)
-      {
-        nodes_[i][j][0].hc = cost * potential_weight_;
-      }
+  cell.obstacle = false;
+  cell.potential = 0;
+
+  if (cost == 0)
+  {
+    return;
+  }
+
+  // obstacle or unknown area
+  if (cost < 0 || obstacle_threshold_ <= cost)
+  {
+    cell.obstacle = true;
+  }
+
+  // the cost more than threshold is regarded almost same as an obstacle
+  // because of its very high cost
+  if (use_potential_heuristic_)
+  {
+    cell.potential = cost * potential_weight_;
+  }
+}
+
+size_t AstarSearch::getNodeIndex(int index_x, int index_y, int index_theta)
+{
+  return (static_cast<size_t>(index_y) * costmap_.info.width + index_x) * theta_size_ + index_theta;
+}
+
+AstarNode& AstarSearch::getNode(int index_x, int index_y, int index_theta)
+{
+  AstarNode& node = nodes_[getNodeIndex(index_x, index_y, index_theta)];
+
+  // Nodes touched in previous searches are regarded as unvisited
+  if (node.generation != generation_)
+  {
+    node.status = STATUS::NONE;
+    node.hc = 0;
+    node.generation = generation_;
+  }
+
+  return node;
+}
+
+// Wavefront heuristic cost if it was set in this search, otherwise the potential cost
+double AstarSearch::getCellCost(int index_x, int index_y)
+{
+  const AstarCell& cell = cells_[index_y * costmap_.info.width + index_x];
+  return cell.generation == generation_ ? cell.hc : cell.potential;
+}
+
+// Whether the wavefront heuristic cost of the cell was set in this search
+bool AstarSearch::isCellVisited(int index_x, int index_y)
+{
+  return cells_[index_y * costmap_.info.width + index_x].generation == generation_;
+}
+
+void AstarSearch::setCellCost(int index_x, int index_y, double hc)
+{
+  AstarCell& cell = cells_[index_y * costmap_.info.width + index_x];
+  cell.hc = hc;
+  cell.generation = generation_;
+}
+
+void AstarSearch::invalidateNodes()
+{
+  generation_++;
+
+  // Clear stale stamps only when the counter wraps around
+  if (generation_ == 0)
+  {
+    for (auto& node : nodes_)
+    {
+      node.generation = 0;
+    }
+    for (auto& cell : cells_)
+    {
+      cell.generation = 0;
     }
+    generation_ = 1;
   }
 }
 
@@ -226,7 +503,8 @@ bool AstarSearch::setStartNode(const geometry_msgs::Pose& start_pose)
   }
 
   // Set start node
-  AstarNode& start_node = nodes_[index_y][index_x][index_theta];
+  AstarNode& start_node = getNode(index_x, index_y, index_theta);
+  start_node.hc = getCellCost(index_x, index_y);
   start_node.x = start_pose_local_.pose.position.x;
   start_node.y = start_pose_local_.pose.position.y;
   start_node.theta = 2.0 * M_PI / theta_size_ * index_theta;
@@ -253,7 +531,7 @@ bool AstarSearch::setStartNode(const geometry_msgs::Pose& start_pose)
 
   // Push start node to openlist
   start_sn.cost = start_node.gc + start_node.hc;
-  openlist_.push(start_sn);
+  openlist_->push(start_sn, getNodeIndex(index_x, index_y, index_theta));
 
   return true;
 }
@@ -262,6 +540,8 @@ bool AstarSearch::setGoalNode(const geometry_msgs::Pose& goal_pose)
 {
   goal_pose_local_.pose = goal_pose;
   goal_yaw_ = modifyTheta(tf::getYaw(goal_pose_local_.pose.orientation));
+  goal_cos_ = std::cos(goal_yaw_);
+  goal_sin_ = std::sin(goal_yaw_);
 
   // Get index of goal pose
   int index_x, index_y, index_theta;
@@ -295,31 +575,37 @@ bool AstarSearch::setGoalNode(const geometry_msgs::Pose& goal_pose)
 
 void AstarSearch::poseToIndex(const geometry_msgs::Pose& pose, int* index_x, int* index_y, int* index_theta)
 {
-  tf::Transform orig_tf;
-  tf::poseMsgToTF(costmap_.info.origin, orig_tf);
-  geometry_msgs::Pose pose2d = transformPose(pose, orig_tf.inverse());
+  xytToIndex(pose.position.x, pose.position.y, tf::getYaw(pose.orientation), index_x, index_y, index_theta);
+}
 
-  *index_x = pose2d.position.x / costmap_.info.resolution;
-  *index_y = pose2d.position.y / costmap_.info.resolution;
+void AstarSearch::xytToIndex(double x, double y, double theta, int* index_x, int* index_y, int* index_theta)
+{
+  pointToIndex(x, y, index_x, index_y);
 
-  tf::Quaternion quat;
-  tf::quaternionMsgToTF(pose2d.orientation, quat);
-  double yaw = tf::getYaw(quat);
+  // Yaw seen from the costmap origin
+  double yaw = std::remainder(theta - origin_yaw_, 2.0 * M_PI);
   if (yaw < 0)
     yaw += 2.0 * M_PI;
 
   // Descretize angle
-  static double one_angle_range = 2.0 * M_PI / theta_size_;
+  double one_angle_range = 2.0 * M_PI / theta_size_;
   *index_theta = yaw / one_angle_range;
   *index_theta %= theta_size_;
 }
 
 void AstarSearch::pointToIndex(const geometry_msgs::Point& point, int* index_x, int* index_y)
 {
-  geometry_msgs::Pose pose;
-  pose.position = point;
-  int index_theta;
-  poseToIndex(pose, index_x, index_y, &index_theta);
+  pointToIndex(point.x, point.y, index_x, index_y);
+}
+
+void AstarSearch::pointToIndex(double x, double y, int* index_x, int* index_y)
+{
+  // Inverse 2D transform of the costmap origin
+  double dx = x - origin_x_;
+  double dy = y - origin_y_;
+
+  *index_x = (origin_cos_ * dx + origin_sin_ * dy) / costmap_.info.resolution;
+  *index_y = (-origin_sin_ * dx + origin_cos_ * dy) / costmap_.info.resolution;
 }
 
 bool AstarSearch::isOutOfRange(int index_x, int index_y)
@@ -335,10 +621,11 @@ bool AstarSearch::isOutOfRange(int index_x, int index_y)
 bool AstarSearch::search()
 {
   ros::WallTime begin = ros::WallTime::now();
+  expansion_count_ = 0;
 
   // Start A* search
   // If the openlist is empty, search failed
-  while (!openlist_.empty())
+  while (!openlist_->empty())
   {
     // Check time and terminate if the search reaches the time limit
     ros::WallTime now = ros::WallTime::now();
@@ -350,11 +637,10 @@ bool AstarSearch::search()
     }
 
     // Pop minimum cost node from openlist
-    SimpleNode top_sn = openlist_.top();
-    openlist_.pop();
+    SimpleNode top_sn = openlist_->pop();
 
     // Expand nodes from this node
-    AstarNode* current_an = &nodes_[top_sn.index_y][top_sn.index_x][top_sn.index_theta];
+    AstarNode* current_an = &getNode(top_sn.index_x, top_sn.index_y, top_sn.index_theta);
     current_an->status = STATUS::CLOSED;
 
     // Goal check
@@ -365,6 +651,13 @@ bool AstarSearch::search()
       return true;
     }
 
+    // Shoot a curve to the goal, the rest of the search is skipped if it is collision free
+    expansion_count_++;
+    if (use_analytic_expansion_ && expansion_count_ % analytic_expansion_interval_ == 0 && tryAnalyticExpansion(top_sn))
+    {
+      return true;
+    }
+
     // Expand nodes
     for (const auto& state : state_update_table_[top_sn.index_theta])
     {
@@ -381,10 +674,7 @@ bool AstarSearch::search()
 
       // Calculate index of the next state
       SimpleNode next_sn;
-      geometry_msgs::Point next_pos;
-      next_pos.x = next_x;
-      next_pos.y = next_y;
-      pointToIndex(next_pos, &next_sn.index_x, &next_sn.index_y);
+      pointToIndex(next_x, next_y, &next_sn.index_x, &next_sn.index_y);
       next_sn.index_theta = top_sn.index_theta + state.index_theta;
 
       // Avoid invalid index
@@ -396,14 +686,15 @@ bool AstarSearch::search()
         continue;
       }
 
-      AstarNode* next_an = &nodes_[next_sn.index_y][next_sn.index_x][next_sn.index_theta];
+      AstarNode* next_an = &getNode(next_sn.index_x, next_sn.index_y, next_sn.index_theta);
+      double cell_cost = getCellCost(next_sn.index_x, next_sn.index_y);
       double next_gc = current_an->gc + move_cost;
-      double next_hc = nodes_[next_sn.index_y][next_sn.index_x][0].hc;  // wavefront or distance transform heuristic
+      double next_hc = cell_cost;  // wavefront or distance transform heuristic
 
       // increase the cost with euclidean distance
       if (use_potential_heuristic_)
       {
-        next_gc += nodes_[next_sn.index_y][next_sn.index_x][0].hc;
+        next_gc += cell_cost;
         next_hc += calcDistance(next_x, next_y, goal_pose_local_.pose.position.x, goal_pose_local_.pose.position.y) *
                    distance_heuristic_weight_;
       }
@@ -428,7 +719,7 @@ bool AstarSearch::search()
         next_an->back = state.back;
         next_an->parent = current_an;
         next_sn.cost = next_an->gc + next_an->hc;
-        openlist_.push(next_sn);
+        openlist_->push(next_sn, getNodeIndex(next_sn.index_x, next_sn.index_y, next_sn.index_theta));
         continue;
       }
 
@@ -447,7 +738,7 @@ bool AstarSearch::search()
           next_an->back = state.back;
           next_an->parent = current_an;
           next_sn.cost = next_an->gc + next_an->hc;
-          openlist_.push(next_sn);
+          openlist_->push(next_sn, getNodeIndex(next_sn.index_x, next_sn.index_y, next_sn.index_theta));
           continue;
         }
       }
@@ -467,19 +758,13 @@ void AstarSearch::setPath(const SimpleNode& goal)
   path_.header = header;
 
   // From the goal node to the start node
-  AstarNode* node = &nodes_[goal.index_y][goal.index_x][goal.index_theta];
+  AstarNode* node = &getNode(goal.index_x, goal.index_y, goal.index_theta);
 
   while (node != NULL)
   {
-    // Set tf pose
-    tf::Vector3 origin(node->x, node->y, 0);
-    tf::Pose tf_pose;
-    tf_pose.setOrigin(origin);
-    tf_pose.setRotation(tf::createQuaternionFromYaw(node->theta));
-
     // Set path as ros message
     geometry_msgs::PoseStamped ros_pose;
-    tf::poseTFToMsg(tf_pose, ros_pose.pose);
+    ros_pose.pose = xytToPoseMsg(node->x, node->y, node->theta);
     ros_pose.header = header;
     path_.poses.push_back(ros_pose);
 
@@ -491,25 +776,71 @@ void AstarSearch::setPath(const SimpleNode& goal)
   std::reverse(path_.poses.begin(), path_.poses.end());
 }
 
+// Connect the node to the goal with the shortest curve of the minimum turning radius
+// Set the path and return true if the curve is collision free
+bool AstarSearch::tryAnalyticExpansion(const SimpleNode& sn)
+{
+  const AstarNode& node = getNode(sn.index_x, sn.index_y, sn.index_theta);
+  double goal_x = goal_pose_local_.pose.position.x;
+  double goal_y = goal_pose_local_.pose.position.y;
+
+  AnalyticPath curve =
+      use_back_ ? calcReedsSheppPath(node.x, node.y, node.theta, goal_x, goal_y, goal_yaw_, minimum_turning_radius_) :
+                  calcDubinsPath(node.x, node.y, node.theta, goal_x, goal_y, goal_yaw_, minimum_turning_radius_);
+
+  // Sample poses at intervals of the costmap resolution, excluding the node itself
+  double length = curve.totalLength() * minimum_turning_radius_;
+  double interval = costmap_.info.resolution;
+  int sample_num = std::ceil(length / interval);
+  std::vector<geometry_msgs::Pose> samples;
+  samples.reserve(sample_num);
+  for (int i = 1; i <= sample_num; i++)
+  {
+    double x, y, theta;
+    bool back;
+    interpolateAnalyticPath(curve, node.x, node.y, node.theta, minimum_turning_radius_,
+                            std::min(i * interval, length), &x, &y, &theta, &back);
+
+    SimpleNode sample_sn;
+    xytToIndex(x, y, theta, &sample_sn.index_x, &sample_sn.index_y, &sample_sn.index_theta);
+    if (isOutOfRange(sample_sn.index_x, sample_sn.index_y) || detectCollision(sample_sn))
+    {
+      return false;
+    }
+
+    samples.push_back(xytToPoseMsg(x, y, theta));
+  }
+
+  // Path to the node followed by the curve
+  setPath(sn);
+  for (const auto& pose : samples)
+  {
+    geometry_msgs::PoseStamped ros_pose;
+    ros_pose.pose = pose;
+    ros_pose.header = path_.header;
+    path_.poses.push_back(ros_pose);
+  }
+
+  return true;
+}
+
 // Check if the next state is the goal
 // Check lateral offset, longitudinal offset and angle
 bool AstarSearch::isGoal(double x, double y, double theta)
 {
-  // To reduce computation time, we use square value for distance
-  static const double lateral_goal_range =
-      lateral_goal_range_ / 2.0;  // [meter], divide by 2 means we check left and right
-  static const double longitudinal_goal_range =
-      longitudinal_goal_range_ / 2.0;                                         // [meter], check only behind of the goal
-  static const double goal_angle = M_PI * (angle_goal_range_ / 2.0) / 180.0;  // degrees -> radian
+  double lateral_goal_range = lateral_goal_range_ / 2.0;  // [meter], divide by 2 means we check left and right
+  double longitudinal_goal_range = longitudinal_goal_range_ / 2.0;  // [meter], check only behind of the goal
+  double goal_angle = M_PI * (angle_goal_range_ / 2.0) / 180.0;     // degrees -> radian
 
   // Calculate the node coordinate seen from the goal point
-  tf::Point p(x, y, 0);
-  geometry_msgs::Point relative_node_point = calcRelativeCoordinate(goal_pose_local_.pose, p);
+  double dx = x - goal_pose_local_.pose.position.x;
+  double dy = y - goal_pose_local_.pose.position.y;
+  double relative_x = goal_cos_ * dx + goal_sin_ * dy;
+  double relative_y = -goal_sin_ * dx + goal_cos_ * dy;
 
   // Check Pose of goal
-  if (relative_node_point.x < 0 &&  // shoud be behind of goal
-      std::fabs(relative_node_point.x) < longitudinal_goal_range &&
-      std::fabs(relative_node_point.y) < lateral_goal_range)
+  if (relative_x < 0 &&  // shoud be behind of goal
+      std::fabs(relative_x) < longitudinal_goal_range && std::fabs(relative_y) < lateral_goal_range)
   {
     // Check the orientation of goal
     if (calcDiffOfRadian(goal_yaw_, theta) < goal_angle)
@@ -523,50 +854,75 @@ bool AstarSearch::isGoal(double x, double y, double theta)
 
 bool AstarSearch::isObs(int index_x, int index_y)
 {
-  if (nodes_[index_y][index_x][0].status == STATUS::OBS)
+  return cells_[index_y * costmap_.info.width + index_x].obstacle;
+}
+
+bool AstarSearch::detectCollision(const SimpleNode& sn)
+{
+  // Footprint cells of the robot at this angle
+  const FootprintMask& mask = footprint_table_[sn.index_theta];
+
+  // Range check is needed only when the footprint may stick out of the costmap
+  bool inside = !isOutOfRange(sn.index_x + mask.min_x, sn.index_y + mask.min_y) &&
+                !isOutOfRange(sn.index_x + mask.max_x, sn.index_y + mask.max_y);
+
+  // Most nodes are decided by the distance to obstacles without checking each cell
+  if (use_distance_transform_ && inside)
   {
-    return true;
+    return detectCollisionDistanceTransform(sn, mask);
+  }
+
+  // Check if each footprint cell is Obstacle
+  for (const auto& offset : mask.offsets)
+  {
+    int index_x = sn.index_x + offset.first;
+    int index_y = sn.index_y + offset.second;
+
+    if (!inside && isOutOfRange(index_x, index_y))
+    {
+      return true;
+    }
+    else if (isObs(index_x, index_y))
+    {
+      return true;
+    }
   }
 
   return false;
 }
 
-bool AstarSearch::detectCollision(const SimpleNode& sn)
+// Collision detection with inscribed and circumscribed circles of the robot
+// Only nodes between both circles are checked with the footprint cells
+bool AstarSearch::detectCollisionDistanceTransform(const SimpleNode& sn, const FootprintMask& mask)
 {
-  // Define the robot as rectangle
-  static double left = -1.0 * robot_base2back_;
-  static double right = robot_length_ - robot_base2back_;
-  static double top = robot_width_ / 2.0;
-  static double bottom = -1.0 * robot_width_ / 2.0;
-  static double resolution = costmap_.info.resolution;
-
-  // Coordinate of base_link in OccupancyGrid frame
-  static double one_angle_range = 2.0 * M_PI / theta_size_;
-  double base_x = sn.index_x * resolution;
-  double base_y = sn.index_y * resolution;
-  double base_theta = sn.index_theta * one_angle_range;
-
-  // Calculate cos and sin in advance
-  double cos_theta = std::cos(base_theta);
-  double sin_theta = std::sin(base_theta);
-
-  // Convert each point to index and check if the node is Obstacle
-  for (double x = left; x < right; x += resolution)
-  {
-    for (double y = top; y > bottom; y -= resolution)
-    {
-      // 2D point rotation
-      int index_x = (x * cos_theta - y * sin_theta + base_x) / resolution;
-      int index_y = (x * sin_theta + y * cos_theta + base_y) / resolution;
+  // Cell containing the center of the robot
+  int center_x = std::floor(sn.index_x + mask.center_x);
+  int center_y = std::floor(sn.index_y + mask.center_y);
+  double distance = isOutOfRange(center_x, center_y) ?
+                        0.0 :
+                        cells_[center_y * costmap_.info.width + center_x].obstacle_distance;
+
+  // Margin for discretization: the center and the footprint cells are off from cell centers
+  static const double margin = std::sqrt(2.0);
+
+  // No footprint cell can reach the closest obstacle
+  if (distance > circumscribed_radius_ + margin)
+  {
+    return false;
+  }
 
-      if (isOutOfRange(index_x, index_y))
-      {
-        return true;
-      }
-      else if (nodes_[index_y][index_x][0].status == STATUS::OBS)
-      {
-        return true;
-      }
+  // The closest obstacle cell is entirely inside the robot
+  if (distance < inscribed_radius_ - margin)
+  {
+    return true;
+  }
+
+  // Borderline, check each footprint cell
+  for (const auto& offset : mask.offsets)
+  {
+    if (isObs(sn.index_x + offset.first, sn.index_y + offset.second))
+    {
+      return true;
     }
   }
 
@@ -577,7 +933,7 @@ bool AstarSearch::calcWaveFrontHeuristic(const SimpleNode& sn)
 {
   // Set start point for wavefront search
   // This is goal for Astar search
-  nodes_[sn.index_y][sn.index_x][0].hc = 0;
+  setCellCost(sn.index_x, sn.index_y, 0);
   WaveFrontNode wf_node(sn.index_x, sn.index_y, 1e-10);
   std::queue<WaveFrontNode> qu;
   qu.push(wf_node);
@@ -585,7 +941,7 @@ bool AstarSearch::calcWaveFrontHeuristic(const SimpleNode& sn)
   // State update table for wavefront search
   // Nodes are expanded for each neighborhood cells (moore neighborhood)
   double resolution = costmap_.info.resolution;
-  static std::vector<WaveFrontNode> updates = {
+  std::vector<WaveFrontNode> updates = {
     getWaveFrontNode(0, 1, resolution),
     getWaveFrontNode(-1, 0, resolution),
     getWaveFrontNode(1, 0, resolution),
@@ -618,8 +974,8 @@ bool AstarSearch::calcWaveFrontHeuristic(const SimpleNode& sn)
       next.index_y = ref.index_y + u.index_y;
 
       // out of range OR already visited OR obstacle node
-      if (isOutOfRange(next.index_x, next.index_y) || nodes_[next.index_y][next.index_x][0].hc > 0 ||
-          nodes_[next.index_y][next.index_x][0].status == STATUS::OBS)
+      if (isOutOfRange(next.index_x, next.index_y) || isCellVisited(next.index_x, next.index_y) ||
+          isObs(next.index_x, next.index_y))
       {
         continue;
       }
@@ -638,7 +994,7 @@ bool AstarSearch::calcWaveFrontHeuristic(const SimpleNode& sn)
 
       // Set wavefront heuristic cost
       next.hc = ref.hc + u.hc;
-      nodes_[next.index_y][next.index_x][0].hc = next.hc;
+      setCellCost(next.index_x, next.index_y, next.hc);
 
       qu.push(next);
     }
@@ -652,7 +1008,7 @@ bool AstarSearch::calcWaveFrontHeuristic(const SimpleNode& sn)
 bool AstarSearch::detectCollisionWaveFront(const WaveFrontNode& ref)
 {
   // Define the robot as square
-  static double half = robot_width_ / 2;
+  double half = robot_width_ / 2;
   double robot_x = ref.index_x * costmap_.info.resolution;
   double robot_y = ref.index_y * costmap_.info.resolution;
 
@@ -668,7 +1024,7 @@ bool AstarSearch::detectCollisionWaveFront(const WaveFrontNode& ref)
         return true;
       }
 
-      if (nodes_[index_y][index_x][0].status == STATUS::OBS)
+      if (isObs(index_x, index_y))
       {
         return true;
       }
@@ -683,26 +1039,8 @@ void AstarSearch::reset()
   path_.poses.clear();
 
   // Clear queue
-  std::priority_queue<SimpleNode, std::vector<SimpleNode>, std::greater<SimpleNode>> empty;
-  std::swap(openlist_, empty);
-
-  // ros::WallTime begin = ros::WallTime::now();
-
-  // Reset node info here ...?
-  for (size_t i = 0; i < costmap_.info.height; i++)
-  {
-    for (size_t j = 0; j < costmap_.info.width; j++)
-    {
-      for (int k = 0; k < theta_size_; k++)
-      {
-        // other values will be updated during the search
-        nodes_[i][j][k].status = STATUS::NONE;
-        nodes_[i][j][k].hc = 0;
-      }
-    }
-  }
-
-  // ros::WallTime end = ros::WallTime::now();
+  openlist_->clear();
 
-  // ROS_INFO("Reset time: %lf [ms]", (end - begin).toSec() * 1000);
+  // Reset node info, nodes are re-initialized lazily in getNode()
+  invalidateNodes();
 }
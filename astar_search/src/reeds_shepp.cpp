@@ -0,0 +1,569 @@
+/*
+ * Copyright 2015-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "astar_search/reeds_shepp.h"
+
+namespace
+{
+const double ZERO = 1e-9;
+
+const SegmentType L = SegmentType::LEFT;
+const SegmentType S = SegmentType::STRAIGHT;
+const SegmentType R = SegmentType::RIGHT;
+const SegmentType N = SegmentType::NOP;
+
+// Reeds-Shepp path words
+const std::array<SegmentType, 5> RS_TYPES[18] = {
+  { L, R, L, N, N },  // 0
+  { R, L, R, N, N },  // 1
+  { L, R, L, R, N },  // 2
+  { R, L, R, L, N },  // 3
+  { L, R, S, L, N },  // 4
+  { R, L, S, R, N },  // 5
+  { L, S, R, L, N },  // 6
+  { R, S, L, R, N },  // 7
+  { L, R, S, R, N },  // 8
+  { R, L, S, L, N },  // 9
+  { R, S, R, L, N },  // 10
+  { L, S, L, R, N },  // 11
+  { L, S, R, N, N },  // 12
+  { R, S, L, N, N },  // 13
+  { L, S, L, N, N },  // 14
+  { R, S, R, N, N },  // 15
+  { L, R, S, L, R },  // 16
+  { R, L, S, R, L },  // 17
+};
+
+// Dubins path words
+const std::array<SegmentType, 5> DUBINS_TYPES[6] = {
+  { L, S, L, N, N },  // LSL
+  { R, S, R, N, N },  // RSR
+  { R, S, L, N, N },  // RSL
+  { L, S, R, N, N },  // LSR
+  { R, L, R, N, N },  // RLR
+  { L, R, L, N, N },  // LRL
+};
+
+// angle in [-pi, pi]
+double wrapToPi(double x)
+{
+  double v = std::fmod(x, 2.0 * M_PI);
+  if (v < -M_PI)
+    v += 2.0 * M_PI;
+  else if (v > M_PI)
+    v -= 2.0 * M_PI;
+  return v;
+}
+
+// angle in [0, 2pi)
+double wrapTo2Pi(double x)
+{
+  double v = x - 2.0 * M_PI * std::floor(x / (2.0 * M_PI));
+  if (2.0 * M_PI - v < ZERO)
+    v = 0.0;
+  return v;
+}
+
+void polar(double x, double y, double& r, double& theta)
+{
+  r = std::hypot(x, y);
+  theta = std::atan2(y, x);
+}
+
+void tauOmega(double u, double v, double xi, double eta, double phi, double& tau, double& omega)
+{
+  double delta = wrapToPi(u - v);
+  double a = std::sin(u) - std::sin(delta);
+  double b = std::cos(u) - std::cos(delta) - 1.0;
+  double t1 = std::atan2(eta * a - xi * b, xi * a + eta * b);
+  double t2 = 2.0 * (std::cos(delta) - std::cos(v) - std::cos(u)) + 3.0;
+  tau = (t2 < 0) ? wrapToPi(t1 + M_PI) : wrapToPi(t1);
+  omega = wrapToPi(tau - u + v - phi);
+}
+
+// Keep the shorter of the current path and the candidate
+void update(AnalyticPath& path, const std::array<SegmentType, 5>& type, double t, double u, double v,
+            double w = 0.0, double x = 0.0)
+{
+  AnalyticPath candidate(type, t, u, v, w, x);
+  if (candidate.totalLength() < path.totalLength())
+  {
+    path = candidate;
+  }
+}
+
+// formula 8.1
+bool LpSpLp(double x, double y, double phi, double& t, double& u, double& v)
+{
+  polar(x - std::sin(phi), y - 1.0 + std::cos(phi), u, t);
+  if (t >= -ZERO)
+  {
+    v = wrapToPi(phi - t);
+    if (v >= -ZERO)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// formula 8.2
+bool LpSpRp(double x, double y, double phi, double& t, double& u, double& v)
+{
+  double t1, u1;
+  polar(x + std::sin(phi), y - 1.0 - std::cos(phi), u1, t1);
+  u1 = u1 * u1;
+  if (u1 >= 4.0)
+  {
+    u = std::sqrt(u1 - 4.0);
+    double theta = std::atan2(2.0, u);
+    t = wrapToPi(t1 + theta);
+    v = wrapToPi(t - phi);
+    return t >= -ZERO && v >= -ZERO;
+  }
+  return false;
+}
+
+// formula 8.3 / 8.4
+bool LpRmL(double x, double y, double phi, double& t, double& u, double& v)
+{
+  double xi = x - std::sin(phi);
+  double eta = y - 1.0 + std::cos(phi);
+  double u1, theta;
+  polar(xi, eta, u1, theta);
+  if (u1 <= 4.0)
+  {
+    u = -2.0 * std::asin(0.25 * u1);
+    t = wrapToPi(theta + 0.5 * u + M_PI);
+    v = wrapToPi(phi - t + u);
+    return t >= -ZERO && u <= ZERO;
+  }
+  return false;
+}
+
+// formula 8.7
+bool LpRupLumRm(double x, double y, double phi, double& t, double& u, double& v)
+{
+  double xi = x + std::sin(phi);
+  double eta = y - 1.0 - std::cos(phi);
+  double rho = 0.25 * (2.0 + std::hypot(xi, eta));
+  if (rho <= 1.0)
+  {
+    u = std::acos(rho);
+    tauOmega(u, -u, xi, eta, phi, t, v);
+    return t >= -ZERO && v <= ZERO;
+  }
+  return false;
+}
+
+// formula 8.8
+bool LpRumLumRp(double x, double y, double phi, double& t, double& u, double& v)
+{
+  double xi = x + std::sin(phi);
+  double eta = y - 1.0 - std::cos(phi);
+  double rho = (20.0 - xi * xi - eta * eta) / 16.0;
+  if (rho >= 0 && rho <= 1)
+  {
+    u = -std::acos(rho);
+    if (u >= -0.5 * M_PI)
+    {
+      tauOmega(u, u, xi, eta, phi, t, v);
+      return t >= -ZERO && v >= -ZERO;
+    }
+  }
+  return false;
+}
+
+// formula 8.9
+bool LpRmSmLm(double x, double y, double phi, double& t, double& u, double& v)
+{
+  double xi = x - std::sin(phi);
+  double eta = y - 1.0 + std::cos(phi);
+  double rho, theta;
+  polar(xi, eta, rho, theta);
+  if (rho >= 2.0)
+  {
+    double r = std::sqrt(rho * rho - 4.0);
+    u = 2.0 - r;
+    t = wrapToPi(theta + std::atan2(r, -2.0));
+    v = wrapToPi(phi - 0.5 * M_PI - t);
+    return t >= -ZERO && u <= ZERO && v <= ZERO;
+  }
+  return false;
+}
+
+// formula 8.10
+bool LpRmSmRm(double x, double y, double phi, double& t, double& u, double& v)
+{
+  double xi = x + std::sin(phi);
+  double eta = y - 1.0 - std::cos(phi);
+  double rho, theta;
+  polar(-eta, xi, rho, theta);
+  if (rho >= 2.0)
+  {
+    t = theta;
+    u = 2.0 - rho;
+    v = wrapToPi(t + 0.5 * M_PI - phi);
+    return t >= -ZERO && u <= ZERO && v <= ZERO;
+  }
+  return false;
+}
+
+// formula 8.11
+bool LpRmSLmRp(double x, double y, double phi, double& t, double& u, double& v)
+{
+  double xi = x + std::sin(phi);
+  double eta = y - 1.0 - std::cos(phi);
+  double rho, theta;
+  polar(xi, eta, rho, theta);
+  if (rho >= 2.0)
+  {
+    u = 4.0 - std::sqrt(rho * rho - 4.0);
+    if (u <= ZERO)
+    {
+      t = wrapToPi(std::atan2((4.0 - u) * xi - 2.0 * eta, -2.0 * xi + (u - 4.0) * eta));
+      v = wrapToPi(t - phi);
+      return t >= -ZERO && v >= -ZERO;
+    }
+  }
+  return false;
+}
+
+// Each family is also evaluated on timeflipped (-x, y, -phi) and reflected (x, -y, -phi) goals
+void CSC(double x, double y, double phi, AnalyticPath& path)
+{
+  double t, u, v;
+  if (LpSpLp(x, y, phi, t, u, v))
+    update(path, RS_TYPES[14], t, u, v);
+  if (LpSpLp(-x, y, -phi, t, u, v))
+    update(path, RS_TYPES[14], -t, -u, -v);
+  if (LpSpLp(x, -y, -phi, t, u, v))
+    update(path, RS_TYPES[15], t, u, v);
+  if (LpSpLp(-x, -y, phi, t, u, v))
+    update(path, RS_TYPES[15], -t, -u, -v);
+  if (LpSpRp(x, y, phi, t, u, v))
+    update(path, RS_TYPES[12], t, u, v);
+  if (LpSpRp(-x, y, -phi, t, u, v))
+    update(path, RS_TYPES[12], -t, -u, -v);
+  if (LpSpRp(x, -y, -phi, t, u, v))
+    update(path, RS_TYPES[13], t, u, v);
+  if (LpSpRp(-x, -y, phi, t, u, v))
+    update(path, RS_TYPES[13], -t, -u, -v);
+}
+
+void CCC(double x, double y, double phi, AnalyticPath& path)
+{
+  double t, u, v;
+  if (LpRmL(x, y, phi, t, u, v))
+    update(path, RS_TYPES[0], t, u, v);
+  if (LpRmL(-x, y, -phi, t, u, v))
+    update(path, RS_TYPES[0], -t, -u, -v);
+  if (LpRmL(x, -y, -phi, t, u, v))
+    update(path, RS_TYPES[1], t, u, v);
+  if (LpRmL(-x, -y, phi, t, u, v))
+    update(path, RS_TYPES[1], -t, -u, -v);
+
+  // backwards
+  double xb = x * std::cos(phi) + y * std::sin(phi);
+  double yb = x * std::sin(phi) - y * std::cos(phi);
+  if (LpRmL(xb, yb, phi, t, u, v))
+    update(path, RS_TYPES[0], v, u, t);
+  if (LpRmL(-xb, yb, -phi, t, u, v))
+    update(path, RS_TYPES[0], -v, -u, -t);
+  if (LpRmL(xb, -yb, -phi, t, u, v))
+    update(path, RS_TYPES[1], v, u, t);
+  if (LpRmL(-xb, -yb, phi, t, u, v))
+    update(path, RS_TYPES[1], -v, -u, -t);
+}
+
+void CCCC(double x, double y, double phi, AnalyticPath& path)
+{
+  double t, u, v;
+  if (LpRupLumRm(x, y, phi, t, u, v))
+    update(path, RS_TYPES[2], t, u, -u, v);
+  if (LpRupLumRm(-x, y, -phi, t, u, v))
+    update(path, RS_TYPES[2], -t, -u, u, -v);
+  if (LpRupLumRm(x, -y, -phi, t, u, v))
+    update(path, RS_TYPES[3], t, u, -u, v);
+  if (LpRupLumRm(-x, -y, phi, t, u, v))
+    update(path, RS_TYPES[3], -t, -u, u, -v);
+
+  if (LpRumLumRp(x, y, phi, t, u, v))
+    update(path, RS_TYPES[2], t, u, u, v);
+  if (LpRumLumRp(-x, y, -phi, t, u, v))
+    update(path, RS_TYPES[2], -t, -u, -u, -v);
+  if (LpRumLumRp(x, -y, -phi, t, u, v))
+    update(path, RS_TYPES[3], t, u, u, v);
+  if (LpRumLumRp(-x, -y, phi, t, u, v))
+    update(path, RS_TYPES[3], -t, -u, -u, -v);
+}
+
+void CCSC(double x, double y, double phi, AnalyticPath& path)
+{
+  double t, u, v;
+  if (LpRmSmLm(x, y, phi, t, u, v))
+    update(path, RS_TYPES[4], t, -0.5 * M_PI, u, v);
+  if (LpRmSmLm(-x, y, -phi, t, u, v))
+    update(path, RS_TYPES[4], -t, 0.5 * M_PI, -u, -v);
+  if (LpRmSmLm(x, -y, -phi, t, u, v))
+    update(path, RS_TYPES[5], t, -0.5 * M_PI, u, v);
+  if (LpRmSmLm(-x, -y, phi, t, u, v))
+    update(path, RS_TYPES[5], -t, 0.5 * M_PI, -u, -v);
+
+  if (LpRmSmRm(x, y, phi, t, u, v))
+    update(path, RS_TYPES[8], t, -0.5 * M_PI, u, v);
+  if (LpRmSmRm(-x, y, -phi, t, u, v))
+    update(path, RS_TYPES[8], -t, 0.5 * M_PI, -u, -v);
+  if (LpRmSmRm(x, -y, -phi, t, u, v))
+    update(path, RS_TYPES[9], t, -0.5 * M_PI, u, v);
+  if (LpRmSmRm(-x, -y, phi, t, u, v))
+    update(path, RS_TYPES[9], -t, 0.5 * M_PI, -u, -v);
+
+  // backwards
+  double xb = x * std::cos(phi) + y * std::sin(phi);
+  double yb = x * std::sin(phi) - y * std::cos(phi);
+  if (LpRmSmLm(xb, yb, phi, t, u, v))
+    update(path, RS_TYPES[6], v, u, -0.5 * M_PI, t);
+  if (LpRmSmLm(-xb, yb, -phi, t, u, v))
+    update(path, RS_TYPES[6], -v, -u, 0.5 * M_PI, -t);
+  if (LpRmSmLm(xb, -yb, -phi, t, u, v))
+    update(path, RS_TYPES[7], v, u, -0.5 * M_PI, t);
+  if (LpRmSmLm(-xb, -yb, phi, t, u, v))
+    update(path, RS_TYPES[7], -v, -u, 0.5 * M_PI, -t);
+
+  if (LpRmSmRm(xb, yb, phi, t, u, v))
+    update(path, RS_TYPES[10], v, u, -0.5 * M_PI, t);
+  if (LpRmSmRm(-xb, yb, -phi, t, u, v))
+    update(path, RS_TYPES[10], -v, -u, 0.5 * M_PI, -t);
+  if (LpRmSmRm(xb, -yb, -phi, t, u, v))
+    update(path, RS_TYPES[11], v, u, -0.5 * M_PI, t);
+  if (LpRmSmRm(-xb, -yb, phi, t, u, v))
+    update(path, RS_TYPES[11], -v, -u, 0.5 * M_PI, -t);
+}
+
+void CCSCC(double x, double y, double phi, AnalyticPath& path)
+{
+  double t, u, v;
+  if (LpRmSLmRp(x, y, phi, t, u, v))
+    update(path, RS_TYPES[16], t, -0.5 * M_PI, u, -0.5 * M_PI, v);
+  if (LpRmSLmRp(-x, y, -phi, t, u, v))
+    update(path, RS_TYPES[16], -t, 0.5 * M_PI, -u, 0.5 * M_PI, -v);
+  if (LpRmSLmRp(x, -y, -phi, t, u, v))
+    update(path, RS_TYPES[17], t, -0.5 * M_PI, u, -0.5 * M_PI, v);
+  if (LpRmSLmRp(-x, -y, phi, t, u, v))
+    update(path, RS_TYPES[17], -t, 0.5 * M_PI, -u, 0.5 * M_PI, -v);
+}
+
+// Dubins words for normalized distance d and angles alpha, beta from the line between both poses
+void dubinsLSL(double d, double alpha, double beta, AnalyticPath& path)
+{
+  double ca = std::cos(alpha), sa = std::sin(alpha), cb = std::cos(beta), sb = std::sin(beta);
+  double tmp = 2.0 + d * d - 2.0 * (ca * cb + sa * sb - d * (sa - sb));
+  if (tmp >= -ZERO)
+  {
+    double theta = std::atan2(cb - ca, d + sa - sb);
+    update(path, DUBINS_TYPES[0], wrapTo2Pi(-alpha + theta), std::sqrt(std::max(tmp, 0.0)), wrapTo2Pi(beta - theta));
+  }
+}
+
+void dubinsRSR(double d, double alpha, double beta, AnalyticPath& path)
+{
+  double ca = std::cos(alpha), sa = std::sin(alpha), cb = std::cos(beta), sb = std::sin(beta);
+  double tmp = 2.0 + d * d - 2.0 * (ca * cb + sa * sb - d * (sb - sa));
+  if (tmp >= -ZERO)
+  {
+    double theta = std::atan2(ca - cb, d - sa + sb);
+    update(path, DUBINS_TYPES[1], wrapTo2Pi(alpha - theta), std::sqrt(std::max(tmp, 0.0)), wrapTo2Pi(-beta + theta));
+  }
+}
+
+void dubinsRSL(double d, double alpha, double beta, AnalyticPath& path)
+{
+  double ca = std::cos(alpha), sa = std::sin(alpha), cb = std::cos(beta), sb = std::sin(beta);
+  double tmp = d * d - 2.0 + 2.0 * (ca * cb + sa * sb - d * (sa + sb));
+  if (tmp >= -ZERO)
+  {
+    double p = std::sqrt(std::max(tmp, 0.0));
+    double theta = std::atan2(ca + cb, d - sa - sb) - std::atan2(2.0, p);
+    update(path, DUBINS_TYPES[2], wrapTo2Pi(alpha - theta), p, wrapTo2Pi(beta - theta));
+  }
+}
+
+void dubinsLSR(double d, double alpha, double beta, AnalyticPath& path)
+{
+  double ca = std::cos(alpha), sa = std::sin(alpha), cb = std::cos(beta), sb = std::sin(beta);
+  double tmp = -2.0 + d * d + 2.0 * (ca * cb + sa * sb + d * (sa + sb));
+  if (tmp >= -ZERO)
+  {
+    double p = std::sqrt(std::max(tmp, 0.0));
+    double theta = std::atan2(-ca - cb, d + sa + sb) - std::atan2(-2.0, p);
+    update(path, DUBINS_TYPES[3], wrapTo2Pi(-alpha + theta), p, wrapTo2Pi(-beta + theta));
+  }
+}
+
+void dubinsRLR(double d, double alpha, double beta, AnalyticPath& path)
+{
+  double ca = std::cos(alpha), sa = std::sin(alpha), cb = std::cos(beta), sb = std::sin(beta);
+  double tmp = 0.125 * (6.0 - d * d + 2.0 * (ca * cb + sa * sb + d * (sa - sb)));
+  if (std::fabs(tmp) < 1.0)
+  {
+    double p = 2.0 * M_PI - std::acos(tmp);
+    double theta = std::atan2(ca - cb, d - sa + sb);
+    double t = wrapTo2Pi(alpha - theta + 0.5 * p);
+    update(path, DUBINS_TYPES[4], t, p, wrapTo2Pi(alpha - beta - t + p));
+  }
+}
+
+void dubinsLRL(double d, double alpha, double beta, AnalyticPath& path)
+{
+  double ca = std::cos(alpha), sa = std::sin(alpha), cb = std::cos(beta), sb = std::sin(beta);
+  double tmp = 0.125 * (6.0 - d * d + 2.0 * (ca * cb + sa * sb - d * (sa - sb)));
+  if (std::fabs(tmp) < 1.0)
+  {
+    double p = 2.0 * M_PI - std::acos(tmp);
+    double theta = std::atan2(-ca + cb, d + sa - sb);
+    double t = wrapTo2Pi(-alpha + theta + 0.5 * p);
+    update(path, DUBINS_TYPES[5], t, p, wrapTo2Pi(beta - alpha - t + p));
+  }
+}
+}  // namespace
+
+AnalyticPath::AnalyticPath()
+{
+  type.fill(SegmentType::NOP);
+  length.fill(0.0);
+  length[0] = std::numeric_limits<double>::infinity();
+}
+
+AnalyticPath::AnalyticPath(const std::array<SegmentType, 5>& path_type, double t, double u, double v, double w,
+                           double x)
+  : type(path_type), length({ t, u, v, w, x })
+{
+}
+
+double AnalyticPath::totalLength() const
+{
+  double total = 0.0;
+  for (const auto& l : length)
+  {
+    total += std::fabs(l);
+  }
+  return total;
+}
+
+AnalyticPath calcReedsSheppPath(double x1, double y1, double theta1, double x2, double y2, double theta2,
+                                double radius)
+{
+  // Goal seen from the start, normalized by turning radius
+  double dx = x2 - x1;
+  double dy = y2 - y1;
+  double c = std::cos(theta1);
+  double s = std::sin(theta1);
+  double x = (c * dx + s * dy) / radius;
+  double y = (-s * dx + c * dy) / radius;
+  double phi = theta2 - theta1;
+
+  AnalyticPath path;
+  CSC(x, y, phi, path);
+  CCC(x, y, phi, path);
+  CCCC(x, y, phi, path);
+  CCSC(x, y, phi, path);
+  CCSCC(x, y, phi, path);
+  return path;
+}
+
+AnalyticPath calcDubinsPath(double x1, double y1, double theta1, double x2, double y2, double theta2, double radius)
+{
+  double dx = x2 - x1;
+  double dy = y2 - y1;
+  double th = std::atan2(dy, dx);
+  double d = std::hypot(dx, dy) / radius;
+  double alpha = wrapTo2Pi(theta1 - th);
+  double beta = wrapTo2Pi(theta2 - th);
+
+  AnalyticPath path;
+  if (d < ZERO && std::fabs(alpha - beta) < ZERO)
+  {
+    return AnalyticPath(DUBINS_TYPES[0], 0.0, d, 0.0);
+  }
+
+  dubinsLSL(d, alpha, beta, path);
+  dubinsRSR(d, alpha, beta, path);
+  dubinsRSL(d, alpha, beta, path);
+  dubinsLSR(d, alpha, beta, path);
+  dubinsRLR(d, alpha, beta, path);
+  dubinsLRL(d, alpha, beta, path);
+  return path;
+}
+
+void interpolateAnalyticPath(const AnalyticPath& path, double x0, double y0, double theta0, double radius,
+                             double distance, double* x, double* y, double* theta, bool* back)
+{
+  // Integrate segments on the unit circle, then scale by turning radius
+  double seg = distance / radius;
+  double px = 0.0;
+  double py = 0.0;
+  double phi = theta0;
+  *back = false;
+
+  for (size_t i = 0; i < path.length.size() && seg > 0; i++)
+  {
+    double v;
+    if (path.length[i] < 0)
+    {
+      v = std::max(-seg, path.length[i]);
+      seg += v;
+    }
+    else
+    {
+      v = std::min(seg, path.length[i]);
+      seg -= v;
+    }
+
+    if (path.type[i] != SegmentType::NOP)
+    {
+      *back = path.length[i] < 0;
+    }
+
+    switch (path.type[i])
+    {
+      case SegmentType::LEFT:
+        px += std::sin(phi + v) - std::sin(phi);
+        py += -std::cos(phi + v) + std::cos(phi);
+        phi += v;
+        break;
+      case SegmentType::RIGHT:
+        px += -std::sin(phi - v) + std::sin(phi);
+        py += std::cos(phi - v) - std::cos(phi);
+        phi -= v;
+        break;
+      case SegmentType::STRAIGHT:
+        px += v * std::cos(phi);
+        py += v * std::sin(phi);
+        break;
+      case SegmentType::NOP:
+        break;
+    }
+  }
+
+  *x = x0 + px * radius;
+  *y = y0 + py * radius;
+  *theta = phi;
+}
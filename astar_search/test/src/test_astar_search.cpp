@@ -17,6 +17,8 @@
 #include <ros/ros.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 #include "astar_search/astar_search.h"
 
 #include "test_class.h"
@@ -167,3 +169,538 @@ TEST_F(TestSuite, checkMakePlan)
   test_obj_.astar_search_obj.initialize(test_obj_.costmap_);
   ASSERT_TRUE(test_obj_.astar_search_obj.makePlan(start_pose_, goal_pose_)) << "makePlan should return True";
 }
+
+TEST_F(TestSuite, checkResetKeepsCostmap)
+{
+  test_obj_.astar_search_obj.initialize(test_obj_.costmap_);
+  ASSERT_TRUE(test_obj_.astar_search_obj.makePlan(start_pose_, goal_pose_)) << "makePlan should return True";
+  nav_msgs::Path first_path = test_obj_.astar_search_obj.getPath();
+
+  // reset() only invalidates search results, obstacles are kept until the next initialize()
+  test_obj_.astar_search_obj.reset();
+  ASSERT_TRUE(test_obj_.isObs(test_obj_.obstacle_indexes_[0].first, test_obj_.obstacle_indexes_[0].second)) << "obstacle should be kept after reset";
+
+  // Searching again without initialize() gives the same path
+  ASSERT_TRUE(test_obj_.astar_search_obj.makePlan(start_pose_, goal_pose_)) << "makePlan should return True after reset";
+  const nav_msgs::Path& second_path = test_obj_.astar_search_obj.getPath();
+  ASSERT_EQ(first_path.poses.size(), second_path.poses.size()) << "path size should be same after reset";
+  for (size_t i = 0; i < first_path.poses.size(); ++i)
+  {
+    ASSERT_DOUBLE_EQ(first_path.poses[i].pose.position.x, second_path.poses[i].pose.position.x);
+    ASSERT_DOUBLE_EQ(first_path.poses[i].pose.position.y, second_path.poses[i].pose.position.y);
+  }
+}
+
+TEST_F(TestSuite, checkWaveFrontOnPotentialCost)
+{
+  // Cells with potential cost are not regarded as visited by the wavefront search
+  nav_msgs::OccupancyGrid costmap = test_obj_.costmap_;
+  for (auto& cost : costmap.data)
+  {
+    if (cost == 0)
+    {
+      cost = 10;
+    }
+  }
+  test_obj_.astar_search_obj.initialize(costmap);
+  ASSERT_TRUE(test_obj_.setStartNode(start_pose_)) << "start node should be valid";
+
+  test_obj_.poseToIndex(goal_pose_, &index_x, &index_y, &index_theta);
+  SimpleNode goal_sn(index_x, index_y, index_theta, 0, 0);
+  ASSERT_TRUE(test_obj_.calcWaveFrontHeuristic(goal_sn)) << "start should be reachable from goal";
+
+  // Wavefront cost of the previous search is stale after reset()
+  test_obj_.astar_search_obj.reset();
+  ASSERT_TRUE(test_obj_.setStartNode(start_pose_)) << "start node should be valid after reset";
+  ASSERT_TRUE(test_obj_.calcWaveFrontHeuristic(goal_sn)) << "start should be reachable from goal after reset";
+}
+
+// Footprint rasterization done for every node, as detectCollision() did before the footprint table
+bool detectCollisionReference(TestClass& test_obj, const SimpleNode& sn, double resolution, int theta_size)
+{
+  // default robot configs of AstarSearch
+  double left = -1.0;
+  double right = 4.5 - 1.0;
+  double top = 1.75 / 2.0;
+  double bottom = -1.0 * 1.75 / 2.0;
+
+  double base_x = sn.index_x * resolution;
+  double base_y = sn.index_y * resolution;
+  double base_theta = sn.index_theta * 2.0 * M_PI / theta_size;
+  double cos_theta = std::cos(base_theta);
+  double sin_theta = std::sin(base_theta);
+
+  for (double x = left; x < right; x += resolution)
+  {
+    for (double y = top; y > bottom; y -= resolution)
+    {
+      int index_x = (x * cos_theta - y * sin_theta + base_x) / resolution;
+      int index_y = (x * sin_theta + y * cos_theta + base_y) / resolution;
+
+      if (test_obj.isOutOfRange(index_x, index_y) || test_obj.isObs(index_x, index_y))
+      {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+TEST_F(TestSuite, checkFootprintTable)
+{
+  // Costmap with random obstacles
+  nav_msgs::OccupancyGrid costmap = test_obj_.costmap_;
+  costmap.info.resolution = 0.25;
+  costmap.info.width = 60;
+  costmap.info.height = 50;
+  costmap.data.assign(costmap.info.width * costmap.info.height, 0);
+  unsigned int seed = 1;
+  for (auto& cost : costmap.data)
+  {
+    if (rand_r(&seed) % 40 == 0)
+    {
+      cost = 100;
+    }
+  }
+  test_obj_.astar_search_obj.initialize(costmap);
+
+  // The reference truncates negative indexes towards zero, so compare where the footprint stays on the grid
+  int margin = std::ceil(4.5 / costmap.info.resolution);
+  int theta_size = 48;
+  int num_collisions = 0;
+  for (int y = margin; y < static_cast<int>(costmap.info.height); ++y)
+  {
+    for (int x = margin; x < static_cast<int>(costmap.info.width); ++x)
+    {
+      for (int theta = 0; theta < theta_size; ++theta)
+      {
+        SimpleNode sn(x, y, theta, 0, 0);
+        bool expected = detectCollisionReference(test_obj_, sn, costmap.info.resolution, theta_size);
+        ASSERT_EQ(test_obj_.detectCollision(sn), expected) << "[x,y,theta] : [" << x << "," << y << "," << theta << "]";
+        num_collisions += expected;
+      }
+    }
+  }
+  ASSERT_GT(num_collisions, 0) << "some nodes should collide";
+}
+
+TEST_F(TestSuite, checkDistanceTransform)
+{
+  ros::NodeHandle nh("~");
+  nh.setParam("use_distance_transform", true);
+  TestClass dt_obj;
+  nh.setParam("use_distance_transform", false);
+
+  // Cluttered costmap with random obstacles
+  nav_msgs::OccupancyGrid costmap = test_obj_.costmap_;
+  costmap.info.resolution = 0.25;
+  costmap.info.width = 60;
+  costmap.info.height = 50;
+  costmap.data.assign(costmap.info.width * costmap.info.height, 0);
+  unsigned int seed = 2;
+  std::vector<std::pair<int, int>> obstacles;
+  for (int y = 0; y < static_cast<int>(costmap.info.height); ++y)
+  {
+    for (int x = 0; x < static_cast<int>(costmap.info.width); ++x)
+    {
+      if (rand_r(&seed) % 60 == 0)
+      {
+        costmap.data[y * costmap.info.width + x] = 100;
+        obstacles.emplace_back(x, y);
+      }
+    }
+  }
+  test_obj_.astar_search_obj.initialize(costmap);
+  dt_obj.astar_search_obj.initialize(costmap);
+
+  // Distance field equals the brute force distance to the closest obstacle
+  for (int y = 0; y < static_cast<int>(costmap.info.height); ++y)
+  {
+    for (int x = 0; x < static_cast<int>(costmap.info.width); ++x)
+    {
+      double expected = std::numeric_limits<double>::max();
+      for (const auto& obs : obstacles)
+      {
+        expected = std::min(expected, std::hypot(obs.first - x, obs.second - y));
+      }
+      ASSERT_NEAR(dt_obj.getObstacleDistance(x, y), expected, 1e-9)
+          << "[x,y] : [" << x << "," << y << "]";
+    }
+  }
+
+  // Collisions are never missed, and the circles decide almost the same as the footprint
+  int num_nodes = 0;
+  int num_diffs = 0;
+  for (int y = 0; y < static_cast<int>(costmap.info.height); ++y)
+  {
+    for (int x = 0; x < static_cast<int>(costmap.info.width); ++x)
+    {
+      for (int theta = 0; theta < 48; ++theta)
+      {
+        SimpleNode sn(x, y, theta, 0, 0);
+        bool expected = test_obj_.detectCollision(sn);
+        bool result = dt_obj.detectCollision(sn);
+        if (expected)
+        {
+          ASSERT_TRUE(result) << "[x,y,theta] : [" << x << "," << y << "," << theta << "] should collide";
+        }
+        num_nodes++;
+        num_diffs += (expected != result);
+      }
+    }
+  }
+  ASSERT_LT(num_diffs, num_nodes / 100) << "distance transform should rarely be more conservative than footprint";
+}
+
+TEST_F(TestSuite, checkOpenListTypes)
+{
+  ros::NodeHandle nh("~");
+  std::vector<std::string> open_list_types = { "indexed_heap", "bucket" };
+  for (const auto& type : open_list_types)
+  {
+    nh.setParam("open_list_type", type);
+    TestClass test_obj;
+    nh.setParam("open_list_type", "priority_queue");
+
+    // Cluttered costmaps with a free band around start and goal
+    unsigned int seed = 3;
+    for (int scenario = 0; scenario < 4; ++scenario)
+    {
+      nav_msgs::OccupancyGrid costmap = test_obj_.costmap_;
+      costmap.info.resolution = 0.3;
+      costmap.info.width = 120;
+      costmap.info.height = 120;
+      costmap.info.origin.position.x = -18;
+      costmap.info.origin.position.y = -18;
+      costmap.data.assign(costmap.info.width * costmap.info.height, 0);
+      for (int i = 0; i < static_cast<int>(costmap.data.size()); ++i)
+      {
+        int row = i / costmap.info.width;
+        int r = rand_r(&seed) % 100;
+        if (row > 45 && row < 75)
+        {
+          costmap.data[i] = r / 50;
+        }
+        else if (r < 10)
+        {
+          costmap.data[i] = 100;
+        }
+      }
+
+      geometry_msgs::Pose start_pose = start_pose_;
+      geometry_msgs::Pose goal_pose = goal_pose_;
+      start_pose.position.x = -9;
+      goal_pose.position.x = 6 + scenario;
+      goal_pose.position.y = scenario % 2;
+
+      test_obj_.astar_search_obj.initialize(costmap);
+      test_obj.astar_search_obj.initialize(costmap);
+      bool expected = test_obj_.astar_search_obj.makePlan(start_pose, goal_pose);
+      ASSERT_TRUE(expected) << "scenario " << scenario << " should be solvable";
+      ASSERT_EQ(test_obj.astar_search_obj.makePlan(start_pose, goal_pose), expected) << type << " scenario " << scenario;
+
+      // Same path as the priority queue
+      const nav_msgs::Path& expected_path = test_obj_.astar_search_obj.getPath();
+      const nav_msgs::Path& path = test_obj.astar_search_obj.getPath();
+      ASSERT_EQ(path.poses.size(), expected_path.poses.size()) << type << " scenario " << scenario;
+      for (size_t i = 0; i < path.poses.size(); ++i)
+      {
+        ASSERT_DOUBLE_EQ(path.poses[i].pose.position.x, expected_path.poses[i].pose.position.x);
+        ASSERT_DOUBLE_EQ(path.poses[i].pose.position.y, expected_path.poses[i].pose.position.y);
+      }
+
+      test_obj_.astar_search_obj.reset();
+      test_obj.astar_search_obj.reset();
+    }
+  }
+}
+
+TEST_F(TestSuite, checkIncrementalCostmapUpdate)
+{
+  nav_msgs::OccupancyGrid costmap = test_obj_.costmap_;
+  test_obj_.astar_search_obj.initialize(costmap);
+
+  // Costmap of the same geometry updates only changed cells
+  costmap.data[5 * costmap.info.width + 30] = 100;
+  costmap.data[0] = 0;
+  test_obj_.astar_search_obj.initialize(costmap);
+  ASSERT_TRUE(test_obj_.isObs(30, 5)) << "new obstacle should be added";
+  ASSERT_FALSE(test_obj_.isObs(0, 0)) << "removed obstacle should be cleared";
+
+  // Same result as a search initialized from scratch
+  TestClass fresh_obj;
+  fresh_obj.astar_search_obj.initialize(costmap);
+  ASSERT_EQ(test_obj_.astar_search_obj.makePlan(start_pose_, goal_pose_),
+            fresh_obj.astar_search_obj.makePlan(start_pose_, goal_pose_));
+  ASSERT_EQ(test_obj_.astar_search_obj.getPath().poses.size(), fresh_obj.astar_search_obj.getPath().poses.size());
+
+  // Different geometry is ingested from scratch
+  costmap.info.width = 21;
+  costmap.data.assign(costmap.info.width * costmap.info.height, 0);
+  test_obj_.astar_search_obj.initialize(costmap);
+  ASSERT_FALSE(test_obj_.isObs(0, 0)) << "[index_x,index_y] : [0,0] Should NOT be obstacle";
+  ASSERT_TRUE(test_obj_.isOutOfRange(30, 5)) << "[index_x,index_y] : [30,5] Should be outOfRange";
+}
+
+TEST_F(TestSuite, checkIndexOnRotatedOrigin)
+{
+  // Random poses on costmaps with rotated origins
+  unsigned int seed = 4;
+  for (int i = 0; i < 8; ++i)
+  {
+    nav_msgs::OccupancyGrid costmap = test_obj_.costmap_;
+    double origin_yaw = 0.8 * i - 3.0;
+    costmap.info.origin.position.x = -3.7 + i;
+    costmap.info.origin.position.y = 2.1 - i;
+    costmap.info.origin.orientation = tf::createQuaternionMsgFromYaw(origin_yaw);
+    test_obj_.astar_search_obj.initialize(costmap);
+
+    tf::Transform origin_tf;
+    tf::poseMsgToTF(costmap.info.origin, origin_tf);
+
+    for (int j = 0; j < 1000; ++j)
+    {
+      geometry_msgs::Pose pose;
+      pose.position.x = (rand_r(&seed) % 10000) / 100.0 - 50.0;
+      pose.position.y = (rand_r(&seed) % 10000) / 100.0 - 50.0;
+      pose.orientation = tf::createQuaternionMsgFromYaw((rand_r(&seed) % 10000) / 10000.0 * 2.0 * M_PI - M_PI);
+
+      // Index calculated with tf, as poseToIndex() did before
+      geometry_msgs::Pose pose2d = transformPose(pose, origin_tf.inverse());
+      int expected_x = pose2d.position.x / costmap.info.resolution;
+      int expected_y = pose2d.position.y / costmap.info.resolution;
+      double yaw = tf::getYaw(pose2d.orientation);
+      if (yaw < 0)
+        yaw += 2.0 * M_PI;
+      int expected_theta = static_cast<int>(yaw / (2.0 * M_PI / 48)) % 48;
+
+      test_obj_.poseToIndex(pose, &index_x, &index_y, &index_theta);
+      ASSERT_EQ(index_x, expected_x) << "pose " << j << " on origin " << i;
+      ASSERT_EQ(index_y, expected_y) << "pose " << j << " on origin " << i;
+      ASSERT_EQ(index_theta, expected_theta) << "pose " << j << " on origin " << i;
+
+      test_obj_.pointToIndex(pose.position, &index_x, &index_y);
+      ASSERT_EQ(index_x, expected_x) << "point " << j << " on origin " << i;
+      ASSERT_EQ(index_y, expected_y) << "point " << j << " on origin " << i;
+    }
+  }
+}
+
+TEST_F(TestSuite, checkAnalyticExpansion)
+{
+  ros::NodeHandle nh("~");
+  nh.setParam("use_analytic_expansion", true);
+  nh.setParam("analytic_expansion_interval", 5);
+  TestClass test_obj;
+  nh.setParam("use_analytic_expansion", false);
+
+  // Parking lot, a row of slots below the aisle
+  nav_msgs::OccupancyGrid costmap = test_obj_.costmap_;
+  costmap.info.resolution = 0.25;
+  costmap.info.width = 160;
+  costmap.info.height = 100;
+  costmap.info.origin.position.x = -20;
+  costmap.info.origin.position.y = -10;
+  costmap.data.assign(costmap.info.width * costmap.info.height, 0);
+  for (int col = 0; col < static_cast<int>(costmap.info.width); ++col)
+  {
+    for (int row = 0; row < 32; ++row)
+    {
+      // Slot boundaries every 3.5m, bottom wall
+      double x = costmap.info.origin.position.x + (col + 0.5) * costmap.info.resolution;
+      if (row < 4 || std::fabs(std::remainder(x + 1.75, 3.5)) < 0.15)
+      {
+        costmap.data[row * costmap.info.width + col] = 100;
+      }
+    }
+  }
+
+  // Parking scenarios, forward into the slot and backward into the slot
+  std::vector<std::pair<double, double>> starts = { { -14, 2 }, { -12, 3 }, { 10, 3 } };
+  std::vector<double> goal_yaws = { M_PI / 2, -M_PI / 2 };
+  for (const auto& start : starts)
+  {
+    for (double goal_yaw : goal_yaws)
+    {
+      geometry_msgs::Pose start_pose = start_pose_;
+      geometry_msgs::Pose goal_pose = goal_pose_;
+      start_pose.position.x = start.first;
+      start_pose.position.y = start.second;
+      start_pose.orientation = tf::createQuaternionMsgFromYaw(start.first < 0 ? 0 : M_PI);
+      goal_pose.position.x = 0;
+      goal_pose.position.y = goal_yaw > 0 ? -5 : -3;
+      goal_pose.orientation = tf::createQuaternionMsgFromYaw(goal_yaw);
+
+      test_obj_.astar_search_obj.initialize(costmap);
+      test_obj.astar_search_obj.initialize(costmap);
+      ASSERT_TRUE(test_obj_.astar_search_obj.makePlan(start_pose, goal_pose));
+      ASSERT_TRUE(test_obj.astar_search_obj.makePlan(start_pose, goal_pose));
+      int expansions = test_obj_.getExpansionCount();
+      int expansions_with_shot = test_obj.getExpansionCount();
+      ASSERT_LE(expansions_with_shot, expansions);
+
+      // The shot ends exactly at the goal
+      const geometry_msgs::Pose& last = test_obj.astar_search_obj.getPath().poses.back().pose;
+      ASSERT_NEAR(last.position.x, goal_pose.position.x, 1e-6);
+      ASSERT_NEAR(last.position.y, goal_pose.position.y, 1e-6);
+
+      test_obj_.astar_search_obj.reset();
+      test_obj.astar_search_obj.reset();
+    }
+  }
+}
+
+// Average time of fn in microseconds
+template <class Function>
+double measure(int repeat, Function fn)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i)
+  {
+    fn();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / repeat;
+}
+
+/* benchmark, not run by default : --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* */
+TEST_F(TestSuite, DISABLED_BenchmarkResetAndPlan)
+{
+  // Short plan on large empty costmaps, where reset() used to visit every node
+  std::vector<int> sizes = { 160, 240, 320 };
+  for (int size : sizes)
+  {
+    nav_msgs::OccupancyGrid costmap = test_obj_.costmap_;
+    costmap.info.resolution = 0.25;
+    costmap.info.width = size;
+    costmap.info.height = size;
+    costmap.info.origin.position.x = -size * costmap.info.resolution / 2.0;
+    costmap.info.origin.position.y = -size * costmap.info.resolution / 2.0;
+    costmap.data.assign(costmap.info.width * costmap.info.height, 0);
+    test_obj_.astar_search_obj.initialize(costmap);
+
+    double reset_time = measure(20, [&]() { test_obj_.astar_search_obj.reset(); });
+    double plan_time = measure(20, [&]() {
+      test_obj_.astar_search_obj.makePlan(start_pose_, goal_pose_);
+      test_obj_.astar_search_obj.reset();
+    });
+    ASSERT_TRUE(test_obj_.astar_search_obj.makePlan(start_pose_, goal_pose_));
+    std::cout << size << "x" << size << " reset " << reset_time << " [us], makePlan + reset " << plan_time
+              << " [us]" << std::endl;
+  }
+}
+
+/* benchmark, not run by default : --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* */
+TEST_F(TestSuite, DISABLED_BenchmarkDistanceTransform)
+{
+  ros::NodeHandle nh("~");
+  nh.setParam("use_distance_transform", true);
+  TestClass dt_obj;
+  nh.setParam("use_distance_transform", false);
+
+  // Cluttered costmap with a free band around start and goal
+  nav_msgs::OccupancyGrid costmap = test_obj_.costmap_;
+  costmap.info.resolution = 0.25;
+  costmap.info.width = 200;
+  costmap.info.height = 200;
+  costmap.info.origin.position.x = -25;
+  costmap.info.origin.position.y = -25;
+  costmap.data.assign(costmap.info.width * costmap.info.height, 0);
+  unsigned int seed = 5;
+  for (int i = 0; i < static_cast<int>(costmap.data.size()); ++i)
+  {
+    int row = i / costmap.info.width;
+    if ((row < 80 || row > 120) && rand_r(&seed) % 20 == 0)
+    {
+      costmap.data[i] = 100;
+    }
+  }
+
+  geometry_msgs::Pose start_pose = start_pose_;
+  geometry_msgs::Pose goal_pose = goal_pose_;
+  start_pose.position.x = -18;
+  goal_pose.position.x = 18;
+  goal_pose.position.y = 2;
+
+  test_obj_.astar_search_obj.initialize(costmap);
+  dt_obj.astar_search_obj.initialize(costmap);
+  ASSERT_TRUE(test_obj_.astar_search_obj.makePlan(start_pose, goal_pose));
+  ASSERT_TRUE(dt_obj.astar_search_obj.makePlan(start_pose, goal_pose));
+  test_obj_.astar_search_obj.reset();
+  dt_obj.astar_search_obj.reset();
+
+  double footprint_time = measure(10, [&]() {
+    test_obj_.astar_search_obj.makePlan(start_pose, goal_pose);
+    test_obj_.astar_search_obj.reset();
+  });
+  double dt_time = measure(10, [&]() {
+    dt_obj.astar_search_obj.makePlan(start_pose, goal_pose);
+    dt_obj.astar_search_obj.reset();
+  });
+  std::cout << "makePlan footprint " << footprint_time << " [us], distance transform " << dt_time << " [us]"
+            << std::endl;
+}
+
+/* benchmark, not run by default : --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* */
+TEST_F(TestSuite, DISABLED_BenchmarkAnalyticExpansion)
+{
+  ros::NodeHandle nh("~");
+  nh.setParam("use_analytic_expansion", true);
+  nh.setParam("analytic_expansion_interval", 5);
+  TestClass test_obj;
+  nh.setParam("use_analytic_expansion", false);
+
+  // Parking lot of checkAnalyticExpansion, a row of slots below the aisle
+  nav_msgs::OccupancyGrid costmap = test_obj_.costmap_;
+  costmap.info.resolution = 0.25;
+  costmap.info.width = 160;
+  costmap.info.height = 100;
+  costmap.info.origin.position.x = -20;
+  costmap.info.origin.position.y = -10;
+  costmap.data.assign(costmap.info.width * costmap.info.height, 0);
+  for (int col = 0; col < static_cast<int>(costmap.info.width); ++col)
+  {
+    for (int row = 0; row < 32; ++row)
+    {
+      double x = costmap.info.origin.position.x + (col + 0.5) * costmap.info.resolution;
+      if (row < 4 || std::fabs(std::remainder(x + 1.75, 3.5)) < 0.15)
+      {
+        costmap.data[row * costmap.info.width + col] = 100;
+      }
+    }
+  }
+  test_obj_.astar_search_obj.initialize(costmap);
+  test_obj.astar_search_obj.initialize(costmap);
+
+  // Forward and backward into the slot
+  geometry_msgs::Pose start_pose = start_pose_;
+  start_pose.position.x = -12;
+  start_pose.position.y = 3;
+  std::vector<double> goal_yaws = { M_PI / 2, -M_PI / 2 };
+  for (double goal_yaw : goal_yaws)
+  {
+    geometry_msgs::Pose goal_pose = goal_pose_;
+    goal_pose.position.x = 0;
+    goal_pose.position.y = goal_yaw > 0 ? -5 : -3;
+    goal_pose.orientation = tf::createQuaternionMsgFromYaw(goal_yaw);
+
+    ASSERT_TRUE(test_obj_.astar_search_obj.makePlan(start_pose, goal_pose));
+    ASSERT_TRUE(test_obj.astar_search_obj.makePlan(start_pose, goal_pose));
+    int expansions = test_obj_.getExpansionCount();
+    int expansions_with_shot = test_obj.getExpansionCount();
+    test_obj_.astar_search_obj.reset();
+    test_obj.astar_search_obj.reset();
+
+    double time = measure(5, [&]() {
+      test_obj_.astar_search_obj.makePlan(start_pose, goal_pose);
+      test_obj_.astar_search_obj.reset();
+    });
+    double time_with_shot = measure(5, [&]() {
+      test_obj.astar_search_obj.makePlan(start_pose, goal_pose);
+      test_obj.astar_search_obj.reset();
+    });
+    std::cout << "goal yaw " << goal_yaw << " makePlan " << time << " [us] " << expansions << " expansions, with shot "
+              << time_with_shot << " [us] " << expansions_with_shot << " expansions" << std::endl;
+  }
+}
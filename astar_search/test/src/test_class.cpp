@@ -128,3 +128,11 @@ bool TestClass::detectCollisionWaveFront(const WaveFrontNode& sn)
 {
   return astar_search_obj.detectCollisionWaveFront(sn);
 }
+double TestClass::getObstacleDistance(int index_x, int index_y)
+{
+  return astar_search_obj.cells_[index_y * astar_search_obj.costmap_.info.width + index_x].obstacle_distance;
+}
+int TestClass::getExpansionCount()
+{
+  return astar_search_obj.expansion_count_;
+}
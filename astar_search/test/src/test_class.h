@@ -38,6 +38,8 @@ public:
   bool detectCollision(const SimpleNode& sn);
   bool calcWaveFrontHeuristic(const SimpleNode& sn);
   bool detectCollisionWaveFront(const WaveFrontNode& sn);
+  double getObstacleDistance(int index_x, int index_y);
+  int getExpansionCount();
 
   nav_msgs::OccupancyGrid costmap_;
 
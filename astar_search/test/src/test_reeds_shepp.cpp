@@ -0,0 +1,81 @@
+/*
+ * Copyright 2015-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "astar_search/reeds_shepp.h"
+
+TEST(ReedsShepp, checkStraightPath)
+{
+  AnalyticPath path = calcReedsSheppPath(0, 0, 0, 10, 0, 0, 5);
+  ASSERT_DOUBLE_EQ(path.totalLength() * 5, 10);
+
+  double x, y, theta;
+  bool back;
+  interpolateAnalyticPath(path, 0, 0, 0, 5, 4, &x, &y, &theta, &back);
+  ASSERT_NEAR(x, 4, 1e-9);
+  ASSERT_NEAR(y, 0, 1e-9);
+  ASSERT_FALSE(back);
+
+  // Straight backward
+  path = calcReedsSheppPath(0, 0, 0, -10, 0, 0, 5);
+  ASSERT_DOUBLE_EQ(path.totalLength() * 5, 10);
+  interpolateAnalyticPath(path, 0, 0, 0, 5, 4, &x, &y, &theta, &back);
+  ASSERT_NEAR(x, -4, 1e-9);
+  ASSERT_TRUE(back);
+}
+
+TEST(ReedsShepp, checkEndPose)
+{
+  // Random pose pairs, the end of the path is the goal pose
+  unsigned int seed = 5;
+  double radius = 6.0;
+  for (int i = 0; i < 1000; ++i)
+  {
+    double pose[6];
+    for (int j = 0; j < 6; ++j)
+    {
+      pose[j] = (rand_r(&seed) % 10000) / 10000.0 * 40.0 - 20.0;
+    }
+
+    AnalyticPath reeds_shepp = calcReedsSheppPath(pose[0], pose[1], pose[2], pose[3], pose[4], pose[5], radius);
+    AnalyticPath dubins = calcDubinsPath(pose[0], pose[1], pose[2], pose[3], pose[4], pose[5], radius);
+
+    // Going backward never makes the path longer
+    ASSERT_LE(reeds_shepp.totalLength(), dubins.totalLength() + 1e-9) << "pose pair " << i;
+
+    for (const auto& path : { reeds_shepp, dubins })
+    {
+      ASSERT_TRUE(std::isfinite(path.totalLength())) << "pose pair " << i;
+
+      double x, y, theta;
+      bool back;
+      interpolateAnalyticPath(path, pose[0], pose[1], pose[2], radius, path.totalLength() * radius, &x, &y, &theta,
+                              &back);
+      ASSERT_NEAR(x, pose[3], 1e-6) << "pose pair " << i;
+      ASSERT_NEAR(y, pose[4], 1e-6) << "pose pair " << i;
+      ASSERT_NEAR(std::remainder(theta - pose[5], 2.0 * M_PI), 0, 1e-6) << "pose pair " << i;
+    }
+
+    // Dubins path never goes backward
+    for (double length : dubins.length)
+    {
+      ASSERT_GE(length, 0) << "pose pair " << i;
+    }
+  }
+}
@@ -45,6 +45,7 @@
 #include "autoware_msgs/DetectedObjectArray.h"
 #include "points_to_costmap.h"
 #include "objects_to_costmap.h"
+#include "wayarea_to_costmap.h"
 
 // headers in STL
 #include <memory>
@@ -101,6 +102,7 @@ private:
 
   PointsToCostmap points2costmap_;
   ObjectsToCostmap objects2costmap_;
+  WayareaToCostmap wayarea2costmap_;
 
   const std::string OBJECTS_BOX_COSTMAP_LAYER_;
   const std::string OBJECTS_CONVEX_HULL_COSTMAP_LAYER_;
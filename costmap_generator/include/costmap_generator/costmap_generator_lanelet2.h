@@ -46,6 +46,7 @@
 #include <autoware_msgs/DetectedObjectArray.h>
 #include <costmap_generator/objects_to_costmap.h>
 #include <costmap_generator/points_to_costmap.h>
+#include <costmap_generator/wayarea_to_costmap.h>
 #include <lanelet2_extension/utility/message_conversion.h>
 
 // headers in STL
@@ -106,6 +107,7 @@ private:
 
   PointsToCostmap points2costmap_;
   ObjectsToCostmap objects2costmap_;
+  WayareaToCostmap wayarea2costmap_;
 
   const std::string OBJECTS_BOX_COSTMAP_LAYER_;
   const std::string OBJECTS_CONVEX_HULL_COSTMAP_LAYER_;
@@ -61,6 +61,13 @@ public:
 private:
   friend class TestClass;
 
+  /// \brief points binned into one grid cell
+  struct GridCellPoints
+  {
+    int num_points;           // all points in the cell
+    int num_points_in_range;  // points between minimum and maximum height threshold
+  };
+
   double grid_length_x_;
   double grid_length_y_;
   double grid_resolution_;
@@ -69,6 +76,9 @@ private:
   double y_cell_size_;
   double x_cell_size_;
 
+  // flat grid reused across pointclouds, (x_ind, y_ind) is at x_ind + y_ind * x_cell_size_
+  std::vector<GridCellPoints> grid_cells_;
+
   /// \brief initialize gridmap parameters
   /// \param[in] gridmap: gridmap object to be initialized
   void initGridmapParam(const grid_map::GridMap& gridmap);
@@ -90,6 +100,13 @@ private:
   std::vector<std::vector<std::vector<double>>>
   assignPoints2GridCell(const grid_map::GridMap& gridmap, const pcl::PointCloud<pcl::PointXYZ>::Ptr& in_sensor_points);
 
+  /// \brief Count pointcloud in each cell of gridmap in a single pass, without storing point's height
+  /// \param[in] maximum_height_thres: Maximum height threshold for pointcloud data
+  /// \param[in] minimum_height_thres: Minimum height threshold for pointcloud data
+  /// \param[in] in_sensor_points: subscribed pointcloud
+  void binPoints2GridCell(const double maximum_height_thres, const double minimum_height_thres,
+                          const pcl::PointCloud<pcl::PointXYZ>::Ptr& in_sensor_points);
+
   /// \brief calculate costmap from subscribed pointcloud
   /// \param[in] maximum_height_thres: Maximum height threshold for pointcloud data
   /// \param[in] minimum_height_thres: Minimum height threshold for pointcloud data
@@ -103,7 +120,17 @@ private:
   grid_map::Matrix calculateCostmap(const double maximum_height_thres, const double minimum_lidar_height_thres,
                                     const double grid_min_value, const double grid_max_value,
                                     const grid_map::GridMap& gridmap, const std::string& gridmap_layer_name,
-                                    const std::vector<std::vector<std::vector<double>>> grid_vec);
+                                    const std::vector<std::vector<std::vector<double>>>& grid_vec);
+
+  /// \brief calculate costmap from pointcloud binned by binPoints2GridCell
+  /// \param[in] grid_min_value: Minimum cost for costmap
+  /// \param[in] grid_max_value: Maximum cost fot costmap
+  /// \param[in] gridmap: costmap based on gridmap
+  /// \param[in] gridmap_layer_name: gridmap layer name for gridmap
+  /// \param[out] caculated costmap in grid_map::Matrix format
+  grid_map::Matrix calculateCostmapFromGridCell(const double grid_min_value, const double grid_max_value,
+                                                const grid_map::GridMap& gridmap,
+                                                const std::string& gridmap_layer_name);
 };
 
 #endif  // POINTS_TO_COSTMAP_H
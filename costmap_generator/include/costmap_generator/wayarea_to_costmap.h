@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2018, Nagoya University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ *  * Neither the name of Autoware nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ********************/
+
+#ifndef WAYAREA_TO_COSTMAP_H
+#define WAYAREA_TO_COSTMAP_H
+
+// headers in ROS
+#include <geometry_msgs/Point.h>
+#include <grid_map_ros/grid_map_ros.hpp>
+#include <tf/transform_datatypes.h>
+
+// headers in STL
+#include <map>
+#include <utility>
+#include <vector>
+
+class WayareaToCostmap
+{
+public:
+  WayareaToCostmap();
+  ~WayareaToCostmap();
+
+  /// \brief set road areas, which are rasterized in map frame tiles when they are first needed
+  /// \param[in] area_points: road area polygons in map frame
+  /// \param[in] resolution: resolution of the road area raster
+  void setAreaPoints(const std::vector<std::vector<geometry_msgs::Point>>& area_points, const double resolution);
+
+  /// \brief check if road areas are set
+  /// \param[out] true if there is no road area
+  bool empty() const;
+
+  /// \brief calculate cost from road areas by sampling the cached raster
+  /// \param[in] costmap: initialized gridmap
+  /// \param[in] gridmap_layer_name: gridmap layer name for gridmap
+  /// \param[in] grid_min_value: cost inside road areas
+  /// \param[in] grid_max_value: cost outside road areas
+  /// \param[in] map2costmap: transform from map frame to gridmap frame
+  /// \param[out] calculated cost in grid_map::Matrix format
+  grid_map::Matrix makeCostmapFromWayarea(const grid_map::GridMap& costmap, const std::string& gridmap_layer_name,
+                                          const double grid_min_value, const double grid_max_value,
+                                          const tf::Transform& map2costmap);
+
+private:
+  friend class TestClass;
+
+  typedef std::pair<int, int> TileIndex;
+
+  /// \brief bounding box of a road area in map frame
+  struct AreaBoundingBox
+  {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+  };
+
+  const int TILE_SIZE_;  // cells on a side of a tile
+  const std::string WAYAREA_LAYER_;
+
+  double resolution_;
+  double tile_length_;
+  std::vector<grid_map::Polygon> area_polygons_;
+  std::vector<AreaBoundingBox> area_bounding_boxes_;
+
+  // tiles used in the last costmap, others are released
+  std::map<TileIndex, grid_map::GridMap> tiles_;
+
+  /// \brief rasterize road areas overlapping a tile
+  /// \param[in] tile_index: index of the tile in map frame
+  /// \param[out] tile with 1 inside road areas and 0 outside
+  grid_map::GridMap makeTile(const TileIndex& tile_index) const;
+
+  /// \brief check if a position is in road areas
+  /// \param[in] x: x in map frame
+  /// \param[in] y: y in map frame
+  /// \param[in] used_tiles: tiles used in the current costmap, the tile of the position is added
+  /// \param[out] true if the position is in road areas
+  bool isInWayarea(const double x, const double y, std::map<TileIndex, grid_map::GridMap>* used_tiles);
+};
+
+#endif  // WAYAREA_TO_COSTMAP_H
@@ -152,22 +152,26 @@ CostmapGenerator::generateObjectsCostmap(const autoware_msgs::DetectedObjectArra
 // Only this funstion depends on object_map_utils
 grid_map::Matrix CostmapGenerator::generateVectormapCostmap()
 {
-  grid_map::GridMap vectormap_costmap = costmap_;
   if (use_wayarea_)
   {
     if (!has_subscribed_wayarea_)
     {
       object_map::LoadRoadAreasFromVectorMap(private_nh_, area_points_);
+      if (!area_points_.empty())
+      {
+        has_subscribed_wayarea_ = true;
+        wayarea2costmap_.setAreaPoints(area_points_, grid_resolution_);
+      }
     }
-    if (!area_points_.empty())
+    if (!wayarea2costmap_.empty())
     {
-      has_subscribed_wayarea_ = true;
-      object_map::FillPolygonAreas(vectormap_costmap, area_points_, VECTORMAP_COSTMAP_LAYER_, grid_max_value_,
-                                   grid_min_value_, grid_min_value_, grid_max_value_, lidar_frame_, map_frame_,
-                                   tf_listener_);
+      // road areas are rasterized once in map frame, only the window around the vehicle is sampled
+      tf::StampedTransform map2costmap = object_map::FindTransform(lidar_frame_, map_frame_, tf_listener_);
+      return wayarea2costmap_.makeCostmapFromWayarea(costmap_, VECTORMAP_COSTMAP_LAYER_, grid_min_value_,
+                                                     grid_max_value_, map2costmap);
     }
   }
-  return vectormap_costmap[VECTORMAP_COSTMAP_LAYER_];
+  return costmap_[VECTORMAP_COSTMAP_LAYER_];
 }
 
 grid_map::Matrix CostmapGenerator::generateCombinedCostmap()
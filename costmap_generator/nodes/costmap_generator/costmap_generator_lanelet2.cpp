@@ -119,6 +119,7 @@ void CostmapGeneratorLanelet2::laneletBinMapCallback(const autoware_lanelet2_msg
   lanelet::utils::conversion::fromBinMsg(msg, lanelet_map_);
   loaded_lanelet_map_ = true;
   loadRoadAreasFromLaneletMap(lanelet_map_, &area_points_);
+  wayarea2costmap_.setAreaPoints(area_points_, grid_resolution_);
 }
 
 void CostmapGeneratorLanelet2::objectsCallback(const autoware_msgs::DetectedObjectArray::ConstPtr& in_objects)
@@ -194,15 +195,14 @@ grid_map::Matrix CostmapGeneratorLanelet2::generateObjectsCostmap(
 
 grid_map::Matrix CostmapGeneratorLanelet2::generateLanelet2Costmap()
 {
-  grid_map::GridMap lanelet2_costmap = costmap_;
-  if (use_wayarea_ && !area_points_.empty())
+  if (use_wayarea_ && !wayarea2costmap_.empty())
   {
-    has_subscribed_wayarea_ = true;
-    object_map::FillPolygonAreas(lanelet2_costmap, area_points_, LANELET2_COSTMAP_LAYER_, grid_max_value_,
-                                 grid_min_value_, grid_min_value_, grid_max_value_, lidar_frame_, map_frame_,
-                                 tf_listener_);
+    // road areas are rasterized once in map frame, only the window around the vehicle is sampled
+    tf::StampedTransform map2costmap = object_map::FindTransform(lidar_frame_, map_frame_, tf_listener_);
+    return wayarea2costmap_.makeCostmapFromWayarea(costmap_, LANELET2_COSTMAP_LAYER_, grid_min_value_,
+                                                   grid_max_value_, map2costmap);
   }
-  return lanelet2_costmap[LANELET2_COSTMAP_LAYER_];
+  return costmap_[LANELET2_COSTMAP_LAYER_];
 }
 
 grid_map::Matrix CostmapGeneratorLanelet2::generateCombinedCostmap()
@@ -46,6 +46,8 @@ void PointsToCostmap::initGridmapParam(const grid_map::GridMap& gridmap)
   grid_resolution_ = gridmap.getResolution();
   grid_position_x_ = gridmap.getPosition().x();
   grid_position_y_ = gridmap.getPosition().y();
+  y_cell_size_ = std::ceil(grid_length_y_ * (1 / grid_resolution_));
+  x_cell_size_ = std::ceil(grid_length_x_ * (1 / grid_resolution_));
 }
 
 bool PointsToCostmap::isValidInd(const grid_map::Index& grid_ind)
@@ -100,7 +102,7 @@ grid_map::Matrix PointsToCostmap::calculateCostmap(const double maximum_height_t
                                                   const double minimum_lidar_height_thres, const double grid_min_value,
                                                   const double grid_max_value, const grid_map::GridMap& gridmap,
                                                   const std::string& gridmap_layer_name,
-                                                  const std::vector<std::vector<std::vector<double>>> grid_vec)
+                                                  const std::vector<std::vector<std::vector<double>>>& grid_vec)
 {
   grid_map::Matrix gridmap_data = gridmap[gridmap_layer_name];
   for (size_t x_ind = 0; x_ind < grid_vec.size(); x_ind++)
@@ -126,14 +128,61 @@ grid_map::Matrix PointsToCostmap::calculateCostmap(const double maximum_height_t
   return gridmap_data;
 }
 
+void PointsToCostmap::binPoints2GridCell(const double maximum_height_thres, const double minimum_height_thres,
+                                         const pcl::PointCloud<pcl::PointXYZ>::Ptr& in_sensor_points)
+{
+  grid_cells_.assign(x_cell_size_ * y_cell_size_, GridCellPoints{ 0, 0 });
+
+  for (const auto& point : *in_sensor_points)
+  {
+    grid_map::Index grid_ind = fetchGridIndexFromPoint(point);
+    if (!isValidInd(grid_ind))
+    {
+      continue;
+    }
+
+    GridCellPoints& cell = grid_cells_[grid_ind.x() + grid_ind.y() * x_cell_size_];
+    cell.num_points++;
+    if (point.z <= maximum_height_thres && point.z >= minimum_height_thres)
+    {
+      cell.num_points_in_range++;
+    }
+  }
+}
+
+grid_map::Matrix PointsToCostmap::calculateCostmapFromGridCell(const double grid_min_value, const double grid_max_value,
+                                                              const grid_map::GridMap& gridmap,
+                                                              const std::string& gridmap_layer_name)
+{
+  grid_map::Matrix gridmap_data = gridmap[gridmap_layer_name];
+  const int x_cell_size = x_cell_size_;
+  const int y_cell_size = y_cell_size_;
+  for (int y_ind = 0; y_ind < y_cell_size; y_ind++)
+  {
+    for (int x_ind = 0; x_ind < x_cell_size; x_ind++)
+    {
+      // cells only with points out of height range keep the current cost
+      const GridCellPoints& cell = grid_cells_[x_ind + y_ind * x_cell_size];
+      if (cell.num_points == 0)
+      {
+        gridmap_data(x_ind, y_ind) = grid_min_value;
+      }
+      else if (cell.num_points_in_range > 0)
+      {
+        gridmap_data(x_ind, y_ind) = grid_max_value;
+      }
+    }
+  }
+  return gridmap_data;
+}
+
 grid_map::Matrix PointsToCostmap::makeCostmapFromSensorPoints(
     const double maximum_height_thres, const double minimum_lidar_height_thres, const double grid_min_value,
     const double grid_max_value, const grid_map::GridMap& gridmap, const std::string& gridmap_layer_name,
     const pcl::PointCloud<pcl::PointXYZ>::Ptr& in_sensor_points)
 {
   initGridmapParam(gridmap);
-  std::vector<std::vector<std::vector<double>>> grid_vec = assignPoints2GridCell(gridmap, in_sensor_points);
-  grid_map::Matrix costmap = calculateCostmap(maximum_height_thres, minimum_lidar_height_thres, grid_min_value,
-                                              grid_max_value, gridmap, gridmap_layer_name, grid_vec);
+  binPoints2GridCell(maximum_height_thres, minimum_lidar_height_thres, in_sensor_points);
+  grid_map::Matrix costmap = calculateCostmapFromGridCell(grid_min_value, grid_max_value, gridmap, gridmap_layer_name);
   return costmap;
 }
@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2018, Nagoya University
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ *  * Neither the name of Autoware nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ ********************/
+
+#include "costmap_generator/wayarea_to_costmap.h"
+
+// Constructor
+WayareaToCostmap::WayareaToCostmap() : TILE_SIZE_(512), WAYAREA_LAYER_("wayarea"), resolution_(0.0), tile_length_(0.0)
+{
+}
+
+WayareaToCostmap::~WayareaToCostmap()
+{
+}
+
+void WayareaToCostmap::setAreaPoints(const std::vector<std::vector<geometry_msgs::Point>>& area_points,
+                                     const double resolution)
+{
+  resolution_ = resolution;
+  tile_length_ = resolution * TILE_SIZE_;
+  area_polygons_.clear();
+  area_bounding_boxes_.clear();
+  tiles_.clear();
+
+  for (const auto& points : area_points)
+  {
+    if (points.empty())
+    {
+      continue;
+    }
+
+    grid_map::Polygon polygon;
+    AreaBoundingBox box = { points[0].x, points[0].y, points[0].x, points[0].y };
+    for (const auto& point : points)
+    {
+      polygon.addVertex(grid_map::Position(point.x, point.y));
+      box.min_x = std::min(box.min_x, point.x);
+      box.min_y = std::min(box.min_y, point.y);
+      box.max_x = std::max(box.max_x, point.x);
+      box.max_y = std::max(box.max_y, point.y);
+    }
+    area_polygons_.push_back(polygon);
+    area_bounding_boxes_.push_back(box);
+  }
+}
+
+bool WayareaToCostmap::empty() const
+{
+  return area_polygons_.empty();
+}
+
+grid_map::GridMap WayareaToCostmap::makeTile(const TileIndex& tile_index) const
+{
+  const double min_x = tile_index.first * tile_length_;
+  const double min_y = tile_index.second * tile_length_;
+  const double max_x = min_x + tile_length_;
+  const double max_y = min_y + tile_length_;
+
+  grid_map::GridMap tile;
+  tile.setGeometry(grid_map::Length(tile_length_, tile_length_), resolution_,
+                   grid_map::Position(min_x + tile_length_ / 2.0, min_y + tile_length_ / 2.0));
+  tile.add(WAYAREA_LAYER_, 0.0);
+
+  for (size_t i = 0; i < area_polygons_.size(); i++)
+  {
+    const AreaBoundingBox& box = area_bounding_boxes_[i];
+    if (box.max_x < min_x || box.min_x > max_x || box.max_y < min_y || box.min_y > max_y)
+    {
+      continue;
+    }
+
+    for (grid_map::PolygonIterator iterator(tile, area_polygons_[i]); !iterator.isPastEnd(); ++iterator)
+    {
+      tile.at(WAYAREA_LAYER_, *iterator) = 1.0;
+    }
+  }
+  return tile;
+}
+
+bool WayareaToCostmap::isInWayarea(const double x, const double y, std::map<TileIndex, grid_map::GridMap>* used_tiles)
+{
+  const TileIndex tile_index(std::floor(x / tile_length_), std::floor(y / tile_length_));
+
+  // reuse the tile from the current or the last costmap, otherwise rasterize it
+  auto used_tile = used_tiles->find(tile_index);
+  if (used_tile == used_tiles->end())
+  {
+    auto cached_tile = tiles_.find(tile_index);
+    if (cached_tile != tiles_.end())
+    {
+      used_tile = used_tiles->emplace(tile_index, std::move(cached_tile->second)).first;
+      tiles_.erase(cached_tile);
+    }
+    else
+    {
+      used_tile = used_tiles->emplace(tile_index, makeTile(tile_index)).first;
+    }
+  }
+
+  grid_map::Index index;
+  if (!used_tile->second.getIndex(grid_map::Position(x, y), index))
+  {
+    return false;
+  }
+  return used_tile->second.at(WAYAREA_LAYER_, index) > 0.0;
+}
+
+grid_map::Matrix WayareaToCostmap::makeCostmapFromWayarea(const grid_map::GridMap& costmap,
+                                                          const std::string& gridmap_layer_name,
+                                                          const double grid_min_value, const double grid_max_value,
+                                                          const tf::Transform& map2costmap)
+{
+  grid_map::Matrix gridmap_data = costmap[gridmap_layer_name];
+  const tf::Transform costmap2map = map2costmap.inverse();
+
+  std::map<TileIndex, grid_map::GridMap> used_tiles;
+  for (grid_map::GridMapIterator iterator(costmap); !iterator.isPastEnd(); ++iterator)
+  {
+    const grid_map::Index index(*iterator);
+    grid_map::Position position;
+    costmap.getPosition(index, position);
+
+    const tf::Vector3 map_point = costmap2map * tf::Vector3(position.x(), position.y(), 0.0);
+    const bool is_in_wayarea = isInWayarea(map_point.x(), map_point.y(), &used_tiles);
+    gridmap_data(index.x(), index.y()) = is_in_wayarea ? grid_min_value : grid_max_value;
+  }
+
+  tiles_.swap(used_tiles);
+  return gridmap_data;
+}
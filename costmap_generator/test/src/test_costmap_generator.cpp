@@ -187,6 +187,99 @@ TEST_F(TestSuite, CheckHeightThresholdForCost)
   EXPECT_DOUBLE_EQ(expected_cost, costmap_mat(5,5));
 }
 
+TEST_F(TestSuite, CheckBinnedPointsCostmap)
+{
+  // Cells only with points out of height range keep this value
+  test_obj_.dummy_costmap_->get(test_obj_.dummy_layer_name_).setConstant(0.5);
+
+  unsigned int seed = 1;
+  for (int i = 0; i < 20; ++i)
+  {
+    // Random cloud covering the grid and outside of it, heights around the thresholds
+    pcl::PointCloud<pcl::PointXYZ>::Ptr in_sensor_points(new pcl::PointCloud<pcl::PointXYZ>);
+    for (int j = 0; j < 10 * i; ++j)
+    {
+      pcl::PointXYZ point;
+      point.x = (rand_r(&seed) % 1400) / 100.0 - 7.0;
+      point.y = (rand_r(&seed) % 1400) / 100.0 - 7.0;
+      point.z = (rand_r(&seed) % 1000) / 100.0 - 5.0;
+      in_sensor_points->push_back(point);
+    }
+
+    grid_map::Matrix expected_mat = test_obj_.calculateCostmap(
+      test_obj_.dummy_maximum_lidar_height_thres_,
+      test_obj_.dummy_minimum_lidar_height_thres_,
+      test_obj_.dummy_grid_min_value_,
+      test_obj_.dummy_grid_max_value_,
+      *test_obj_.dummy_costmap_,
+      test_obj_.dummy_layer_name_,
+      test_obj_.assignPoints2GridCell(*test_obj_.dummy_costmap_, in_sensor_points));
+
+    grid_map::Matrix costmap_mat = test_obj_.makeCostmapFromSensorPoints(
+      test_obj_.dummy_maximum_lidar_height_thres_,
+      test_obj_.dummy_minimum_lidar_height_thres_,
+      test_obj_.dummy_grid_min_value_,
+      test_obj_.dummy_grid_max_value_,
+      *test_obj_.dummy_costmap_,
+      test_obj_.dummy_layer_name_,
+      in_sensor_points);
+
+    ASSERT_EQ(expected_mat.rows(), costmap_mat.rows());
+    ASSERT_EQ(expected_mat.cols(), costmap_mat.cols());
+    for (int x = 0; x < costmap_mat.rows(); ++x)
+    {
+      for (int y = 0; y < costmap_mat.cols(); ++y)
+      {
+        EXPECT_EQ(expected_mat(x, y), costmap_mat(x, y)) << "cloud " << i << " cell " << x << ", " << y;
+      }
+    }
+  }
+}
+
+TEST_F(TestSuite, CheckMakeCostmapFromWayarea)
+{
+  // Square road area across tiles in map frame
+  std::vector<geometry_msgs::Point> area;
+  geometry_msgs::Point point;
+  point.x = -2;
+  point.y = -2;
+  area.push_back(point);
+  point.x = 2;
+  area.push_back(point);
+  point.y = 2;
+  area.push_back(point);
+  point.x = -2;
+  area.push_back(point);
+
+  WayareaToCostmap wayarea2costmap;
+  wayarea2costmap.setAreaPoints(std::vector<std::vector<geometry_msgs::Point>>(1, area),
+                                test_obj_.dummy_costmap_->getResolution());
+
+  // Costmap frame is same as map frame
+  tf::Transform map2costmap;
+  map2costmap.setIdentity();
+  grid_map::GridMap costmap = *test_obj_.dummy_costmap_;
+  costmap[test_obj_.dummy_layer_name_] = wayarea2costmap.makeCostmapFromWayarea(
+    costmap, test_obj_.dummy_layer_name_, test_obj_.dummy_grid_min_value_, test_obj_.dummy_grid_max_value_,
+    map2costmap);
+  EXPECT_EQ(test_obj_.dummy_grid_min_value_,
+            costmap.atPosition(test_obj_.dummy_layer_name_, grid_map::Position(0.5, 0.5)));
+  EXPECT_EQ(test_obj_.dummy_grid_min_value_,
+            costmap.atPosition(test_obj_.dummy_layer_name_, grid_map::Position(-1.5, -1.5)));
+  EXPECT_EQ(test_obj_.dummy_grid_max_value_,
+            costmap.atPosition(test_obj_.dummy_layer_name_, grid_map::Position(3.5, 0.5)));
+
+  // Vehicle moved 3m backward in map frame, cached raster is sampled in the new window
+  map2costmap.setOrigin(tf::Vector3(3, 0, 0));
+  costmap[test_obj_.dummy_layer_name_] = wayarea2costmap.makeCostmapFromWayarea(
+    costmap, test_obj_.dummy_layer_name_, test_obj_.dummy_grid_min_value_, test_obj_.dummy_grid_max_value_,
+    map2costmap);
+  EXPECT_EQ(test_obj_.dummy_grid_min_value_,
+            costmap.atPosition(test_obj_.dummy_layer_name_, grid_map::Position(3.5, 0.5)));
+  EXPECT_EQ(test_obj_.dummy_grid_max_value_,
+            costmap.atPosition(test_obj_.dummy_layer_name_, grid_map::Position(-1.5, 0.5)));
+}
+
 TEST_F(TestSuite, CheckMakeExpandedPoints)
 {
   double expand_polygon_size = 1;
@@ -83,8 +83,13 @@ public:
                                     const double minimum_lidar_height_thres, const double grid_min_value,
                                     const double grid_max_value, const grid_map::GridMap& gridmap,
                                     const std::string& gridmap_layer_name,
-                                    const std::vector<std::vector<std::vector<double>>> grid_vec);
+                                    const std::vector<std::vector<std::vector<double>>>& grid_vec);
 
+  grid_map::Matrix makeCostmapFromSensorPoints(const double maximum_height_thres,
+                                               const double minimum_lidar_height_thres, const double grid_min_value,
+                                               const double grid_max_value, const grid_map::GridMap& gridmap,
+                                               const std::string& gridmap_layer_name,
+                                               const pcl::PointCloud<pcl::PointXYZ>::Ptr& in_sensor_points);
 
   ObjectsToCostmap *objects2costmap_;
   Eigen::MatrixXd makeRectanglePoints(const autoware_msgs::DetectedObject& in_object,
@@ -226,13 +231,24 @@ grid_map::Matrix TestClass::calculateCostmap(const double maximum_height_thres,
                                                   const double minimum_lidar_height_thres, const double grid_min_value,
                                                   const double grid_max_value, const grid_map::GridMap& gridmap,
                                                   const std::string& gridmap_layer_name,
-                                                  const std::vector<std::vector<std::vector<double>>> grid_vec)
+                                                  const std::vector<std::vector<std::vector<double>>>& grid_vec)
 {
   return points2costmap_->calculateCostmap(maximum_height_thres, minimum_lidar_height_thres,
                                           grid_min_value, grid_max_value,
                                           gridmap, gridmap_layer_name, grid_vec);
 }
 
+grid_map::Matrix TestClass::makeCostmapFromSensorPoints(const double maximum_height_thres,
+                                             const double minimum_lidar_height_thres, const double grid_min_value,
+                                             const double grid_max_value, const grid_map::GridMap& gridmap,
+                                             const std::string& gridmap_layer_name,
+                                             const pcl::PointCloud<pcl::PointXYZ>::Ptr& in_sensor_points)
+{
+  return points2costmap_->makeCostmapFromSensorPoints(maximum_height_thres, minimum_lidar_height_thres,
+                                                      grid_min_value, grid_max_value,
+                                                      gridmap, gridmap_layer_name, in_sensor_points);
+}
+
 geometry_msgs::Point TestClass::makeExpandedPoint(const geometry_msgs::Point& in_centroid,
                                        const geometry_msgs::Point32& in_corner_point,
                                        const double expand_polygon_size)
@@ -58,6 +58,7 @@ private:
   tf::Transform local2costmap_;  // local frame (e.g. velodyne) -> costmap origin
 
   bool costmap_initialized_;
+  bool costmap_updated_;  // new costmap has not been passed to A* search yet
   bool current_pose_initialized_;
   bool goal_pose_initialized_;
 
@@ -27,6 +27,7 @@ AstarNavi::AstarNavi() : nh_(), private_nh_("~")
   goal_pose_sub_ = nh_.subscribe("move_base_simple/goal", 1, &AstarNavi::goalPoseCallback, this);
 
   costmap_initialized_ = false;
+  costmap_updated_ = false;
   current_pose_initialized_ = false;
   goal_pose_initialized_ = false;
 }
@@ -41,6 +42,7 @@ void AstarNavi::costmapCallback(const nav_msgs::OccupancyGrid& msg)
   tf::poseMsgToTF(costmap_.info.origin, local2costmap_);
 
   costmap_initialized_ = true;
+  costmap_updated_ = true;
 }
 
 void AstarNavi::currentPoseCallback(const geometry_msgs::PoseStamped& msg)
@@ -111,8 +113,12 @@ void AstarNavi::run()
       continue;
     }
 
-    // initialize vector for A* search, this runs only once
-    astar_.initialize(costmap_);
+    // update costmap for A* search, only when a new costmap has arrived
+    if (costmap_updated_)
+    {
+      astar_.initialize(costmap_);
+      costmap_updated_ = false;
+    }
 
     // update local goal pose
     goalPoseCallback(goal_pose_global_);
@@ -17,6 +17,7 @@
 #ifndef LANE_PLANNER_VMAP_HPP
 #define LANE_PLANNER_VMAP_HPP
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -43,12 +44,19 @@ constexpr int TRAFFIC_LIGHT_UNKNOWN = 2;
 
 constexpr double RADIUS_MAX = 90000000000;
 
+struct VectorMapIndex;
+
 struct VectorMap {
   std::vector<vector_map::Point> points;
   std::vector<vector_map::Lane> lanes;
   std::vector<vector_map::Node> nodes;
   std::vector<vector_map::StopLine> stoplines;
   std::vector<vector_map::DTLane> dtlanes;
+
+  // Lookup tables of the vectors above, built by create_lane_vmap() and immutable with the map.
+  // Code modifying the vectors of such a map must reset() the index, maps without one are indexed
+  // on demand.
+  std::shared_ptr<const VectorMapIndex> index;
 };
 
 void write_waypoints(const std::vector<vector_map::Point>& points, double velocity, const std::string& path);
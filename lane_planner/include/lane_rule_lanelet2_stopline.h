@@ -0,0 +1,69 @@
+/*
+ * Copyright 2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LANE_RULE_LANELET2_STOPLINE_H
+#define LANE_RULE_LANELET2_STOPLINE_H
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/linestring.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <Eigen/Core>
+
+#include <utility>
+#include <vector>
+
+namespace lane_planner
+{
+// traffic light stoplines of a lanelet map, built once for each map
+// and queried with waypoint segments without creating lanelet primitives
+class StopLineRTree
+{
+public:
+  // collect traffic light stoplines of all lanelets of map
+  void build(const lanelet::LaneletMapPtr& map);
+
+  // number of traffic light stoplines of lanelet crossed by waypoint segment p0-p1,
+  // tested in 2d as 3d line segment intersection is not implemented
+  size_t countIntersections(const lanelet::Id lanelet_id, const Eigen::Vector3d& p0, const Eigen::Vector3d& p1) const;
+
+  size_t size() const
+  {
+    return stoplines_.size();
+  }
+
+private:
+  typedef boost::geometry::model::d2::point_xy<double> Point;
+  typedef boost::geometry::model::linestring<Point> LineString;
+  typedef boost::geometry::model::box<Point> Box;
+
+  // one entry for each lanelet referring to the stopline
+  struct StopLine
+  {
+    lanelet::Id lanelet_id;
+    LineString line;
+  };
+
+  std::vector<StopLine> stoplines_;
+  boost::geometry::index::rtree<std::pair<Box, size_t>, boost::geometry::index::quadratic<16> > rtree_;
+};
+}  // namespace lane_planner
+
+#endif  // LANE_RULE_LANELET2_STOPLINE_H
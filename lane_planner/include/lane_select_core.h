@@ -155,6 +155,7 @@ geometry_msgs::Point convertPointIntoRelativeCoordinate(const geometry_msgs::Poi
 geometry_msgs::Point convertPointIntoWorldCoordinate(const geometry_msgs::Point& input_point,
                                                      const geometry_msgs::Pose& pose);
 double getRelativeAngle(const geometry_msgs::Pose& waypoint_pose, const geometry_msgs::Pose& current_pose);
+geometry_msgs::Vector3 getPlanarHeading(const geometry_msgs::Quaternion& orientation);
 bool getLinearEquation(geometry_msgs::Point start, geometry_msgs::Point end, double* a, double* b, double* c);
 double getDistanceBetweenLineAndPoint(geometry_msgs::Point point, double sa, double b, double c);
 }
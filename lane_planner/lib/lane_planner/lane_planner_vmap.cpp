@@ -14,8 +14,14 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <iterator>
 #include <tuple>
+#include <unordered_map>
 
 #include <ros/console.h>
 
@@ -28,35 +34,167 @@ namespace lane_planner {
 
 namespace vmap {
 
+struct VectorMapIndex {
+  using IdTable = std::unordered_map<int, std::vector<size_t>>;
+
+  // sizes of the indexed vectors
+  size_t point_size;
+  size_t lane_size;
+  size_t node_size;
+  size_t stopline_size;
+  size_t dtlane_size;
+
+  // point positions bucketed into square cells on the bx-ly plane
+  int min_ix;
+  int max_ix;
+  int min_iy;
+  int max_iy;
+  std::unordered_map<int64_t, std::vector<size_t>> cells;
+
+  // element positions grouped by id, in vector order
+  IdTable points_by_pid;
+  IdTable nodes_by_nid;
+  IdTable nodes_by_pid;
+  IdTable lanes_by_lnid;
+  IdTable lanes_by_bnid;
+  IdTable stoplines_by_linkid;
+  IdTable dtlanes_by_did;
+};
+
 namespace {
 
+constexpr double INDEX_CELL_SIZE = 10; // meters
+
+int to_cell(double v);
+int to_clamped_cell(double v, int min, int max);
+int64_t to_cell_key(int ix, int iy);
+const std::vector<size_t>& find_ids(const VectorMapIndex::IdTable& table, int id);
+
+std::shared_ptr<const VectorMapIndex> build_index(const VectorMap& vmap);
+std::shared_ptr<const VectorMapIndex> get_index(const VectorMap& vmap);
+
 void write_waypoint(const vector_map::Point& point, double yaw, double velocity, const std::string& path,
         bool first);
 
 double compute_direction_angle(const vector_map::Point& p1, const vector_map::Point& p2);
 
-bool is_branching_point(const VectorMap& vmap, const vector_map::Point& point);
-bool is_merging_point(const VectorMap& vmap, const vector_map::Point& point);
+bool is_branching_point(const VectorMap& vmap, const VectorMapIndex& index, const vector_map::Point& point);
+bool is_merging_point(const VectorMap& vmap, const VectorMapIndex& index, const vector_map::Point& point);
 bool is_branching_lane(const vector_map::Lane& lane);
 bool is_merging_lane(const vector_map::Lane& lane);
 
-vector_map::Point find_start_point(const VectorMap& vmap, const vector_map::Lane& lane);
-vector_map::Point find_end_point(const VectorMap& vmap, const vector_map::Lane& lane);
-vector_map::Point find_departure_point(const VectorMap& lane_vmap, int lno,
+vector_map::Point find_start_point(const VectorMap& vmap, const VectorMapIndex& index, const vector_map::Lane& lane);
+vector_map::Point find_end_point(const VectorMap& vmap, const VectorMapIndex& index, const vector_map::Lane& lane);
+vector_map::Point find_departure_point(const VectorMap& lane_vmap, const VectorMapIndex& index, int lno,
                const std::vector<vector_map::Point>& coarse_points,
                double search_radius);
-vector_map::Point find_arrival_point(const VectorMap& lane_vmap, int lno,
+vector_map::Point find_arrival_point(const VectorMap& lane_vmap, const VectorMapIndex& index, int lno,
              const std::vector<vector_map::Point>& coarse_points,
              double search_radius);
-vector_map::Point find_nearest_point(const VectorMap& vmap, const vector_map::Point& point);
-std::vector<vector_map::Point> find_near_points(const VectorMap& vmap, const vector_map::Point& point,
-            double search_radius);
+vector_map::Point find_nearest_point(const VectorMap& vmap, const VectorMapIndex& index,
+             const vector_map::Point& point);
+std::vector<vector_map::Point> find_near_points(const VectorMap& vmap, const VectorMapIndex& index,
+            const vector_map::Point& point, double search_radius);
+
+size_t find_first_lane_index(const VectorMap& vmap, const VectorMapIndex& index, int lno,
+           std::initializer_list<int> lnids);
+vector_map::Lane find_lane(const VectorMap& vmap, const VectorMapIndex& index, int lno,
+         const vector_map::Point& point);
+vector_map::Lane find_prev_lane(const VectorMap& vmap, const VectorMapIndex& index, int lno,
+        const vector_map::Lane& lane);
+vector_map::Lane find_next_lane(const VectorMap& vmap, const VectorMapIndex& index, int lno,
+        const vector_map::Lane& lane);
+vector_map::Lane find_next_branching_lane(const VectorMap& vmap, const VectorMapIndex& index, int lno,
+            const vector_map::Lane& lane, double coarse_angle, double search_radius);
+
+int to_cell(double v)
+{
+  return static_cast<int>(std::floor(v / INDEX_CELL_SIZE));
+}
+
+int to_clamped_cell(double v, int min, int max)
+{
+  double c = std::floor(v / INDEX_CELL_SIZE);
+  if (c < min)
+    return min;
+  if (c > max)
+    return max;
+  return static_cast<int>(c);
+}
+
+int64_t to_cell_key(int ix, int iy)
+{
+  return (static_cast<int64_t>(ix) << 32) | static_cast<uint32_t>(iy);
+}
+
+const std::vector<size_t>& find_ids(const VectorMapIndex::IdTable& table, int id)
+{
+  static const std::vector<size_t> empty;
+
+  VectorMapIndex::IdTable::const_iterator it = table.find(id);
+  return (it != table.end()) ? it->second : empty;
+}
+
+std::shared_ptr<const VectorMapIndex> build_index(const VectorMap& vmap)
+{
+  std::shared_ptr<VectorMapIndex> index = std::make_shared<VectorMapIndex>();
+  index->point_size = vmap.points.size();
+  index->lane_size = vmap.lanes.size();
+  index->node_size = vmap.nodes.size();
+  index->stopline_size = vmap.stoplines.size();
+  index->dtlane_size = vmap.dtlanes.size();
+
+  index->min_ix = INT_MAX;
+  index->max_ix = INT_MIN;
+  index->min_iy = INT_MAX;
+  index->max_iy = INT_MIN;
+  for (size_t i = 0; i < vmap.points.size(); ++i) {
+    const vector_map::Point& p = vmap.points[i];
+    index->points_by_pid[p.pid].push_back(i);
 
-vector_map::Lane find_lane(const VectorMap& vmap, int lno, const vector_map::Point& point);
-vector_map::Lane find_prev_lane(const VectorMap& vmap, int lno, const vector_map::Lane& lane);
-vector_map::Lane find_next_lane(const VectorMap& vmap, int lno, const vector_map::Lane& lane);
-vector_map::Lane find_next_branching_lane(const VectorMap& vmap, int lno, const vector_map::Lane& lane,
-            double coarse_angle, double search_radius);
+    // never nearer than anything in a linear scan either
+    if (!std::isfinite(p.bx) || !std::isfinite(p.ly))
+      continue;
+    int ix = to_cell(p.bx);
+    int iy = to_cell(p.ly);
+    index->cells[to_cell_key(ix, iy)].push_back(i);
+    index->min_ix = std::min(index->min_ix, ix);
+    index->max_ix = std::max(index->max_ix, ix);
+    index->min_iy = std::min(index->min_iy, iy);
+    index->max_iy = std::max(index->max_iy, iy);
+  }
+
+  for (size_t i = 0; i < vmap.nodes.size(); ++i) {
+    index->nodes_by_nid[vmap.nodes[i].nid].push_back(i);
+    index->nodes_by_pid[vmap.nodes[i].pid].push_back(i);
+  }
+
+  for (size_t i = 0; i < vmap.lanes.size(); ++i) {
+    index->lanes_by_lnid[vmap.lanes[i].lnid].push_back(i);
+    index->lanes_by_bnid[vmap.lanes[i].bnid].push_back(i);
+  }
+
+  for (size_t i = 0; i < vmap.stoplines.size(); ++i)
+    index->stoplines_by_linkid[vmap.stoplines[i].linkid].push_back(i);
+
+  for (size_t i = 0; i < vmap.dtlanes.size(); ++i)
+    index->dtlanes_by_did[vmap.dtlanes[i].did].push_back(i);
+
+  return index;
+}
+
+std::shared_ptr<const VectorMapIndex> get_index(const VectorMap& vmap)
+{
+  // a stored index is valid as long as the map is unmodified (see VectorMap::index),
+  // sizes are checked only to keep the positions in range
+  const std::shared_ptr<const VectorMapIndex>& index = vmap.index;
+  if (index && index->point_size == vmap.points.size() && index->lane_size == vmap.lanes.size() &&
+      index->node_size == vmap.nodes.size() && index->stopline_size == vmap.stoplines.size() &&
+      index->dtlane_size == vmap.dtlanes.size())
+    return index;
+
+  return build_index(vmap);
+}
 
 void write_waypoint(const vector_map::Point& point, double yaw, double velocity, const std::string& path,
         bool first)
@@ -83,22 +221,22 @@ double compute_direction_angle(const vector_map::Point& p1, const vector_map::Po
   return (atan2(p2.ly - p1.ly, p2.bx - p1.bx) * (180 / M_PI)); // -180 to 180 degrees
 }
 
-bool is_branching_point(const VectorMap& vmap, const vector_map::Point& point)
+bool is_branching_point(const VectorMap& vmap, const VectorMapIndex& index, const vector_map::Point& point)
 {
-  vector_map::Lane lane = find_lane(vmap, LNO_ALL, point);
+  vector_map::Lane lane = find_lane(vmap, index, LNO_ALL, point);
   if (lane.lnid < 0)
     return false;
 
-  lane = find_prev_lane(vmap, LNO_ALL, lane);
+  lane = find_prev_lane(vmap, index, LNO_ALL, lane);
   if (lane.lnid < 0)
     return false;
 
   return is_branching_lane(lane);
 }
 
-bool is_merging_point(const VectorMap& vmap, const vector_map::Point& point)
+bool is_merging_point(const VectorMap& vmap, const VectorMapIndex& index, const vector_map::Point& point)
 {
-  vector_map::Lane lane = find_lane(vmap, LNO_ALL, point);
+  vector_map::Lane lane = find_lane(vmap, index, LNO_ALL, point);
   if (lane.lnid < 0)
     return false;
 
@@ -115,62 +253,54 @@ bool is_merging_lane(const vector_map::Lane& lane)
   return (lane.jct == 3 || lane.jct == 4 || lane.jct == 5);
 }
 
-vector_map::Point find_start_point(const VectorMap& vmap, const vector_map::Lane& lane)
+vector_map::Point find_start_point(const VectorMap& vmap, const VectorMapIndex& index, const vector_map::Lane& lane)
 {
   vector_map::Point error;
   error.pid = -1;
 
-  for (const vector_map::Node& n : vmap.nodes) {
-    if (n.nid != lane.bnid)
-      continue;
-    for (const vector_map::Point& p : vmap.points) {
-      if (p.pid != n.pid)
-        continue;
-      return p;
-    }
+  for (size_t n : find_ids(index.nodes_by_nid, lane.bnid)) {
+    const std::vector<size_t>& point_indexes = find_ids(index.points_by_pid, vmap.nodes[n].pid);
+    if (!point_indexes.empty())
+      return vmap.points[point_indexes.front()];
   }
 
   return error;
 }
 
-vector_map::Point find_end_point(const VectorMap& vmap, const vector_map::Lane& lane)
+vector_map::Point find_end_point(const VectorMap& vmap, const VectorMapIndex& index, const vector_map::Lane& lane)
 {
   vector_map::Point error;
   error.pid = -1;
 
-  for (const vector_map::Node& n : vmap.nodes) {
-    if (n.nid != lane.fnid)
-      continue;
-    for (const vector_map::Point& p : vmap.points) {
-      if (p.pid != n.pid)
-        continue;
-      return p;
-    }
+  for (size_t n : find_ids(index.nodes_by_nid, lane.fnid)) {
+    const std::vector<size_t>& point_indexes = find_ids(index.points_by_pid, vmap.nodes[n].pid);
+    if (!point_indexes.empty())
+      return vmap.points[point_indexes.front()];
   }
 
   return error;
 }
 
-vector_map::Point find_departure_point(const VectorMap& lane_vmap, int lno,
+vector_map::Point find_departure_point(const VectorMap& lane_vmap, const VectorMapIndex& index, int lno,
                const std::vector<vector_map::Point>& coarse_points,
                double search_radius)
 {
   vector_map::Point coarse_p1 = coarse_points[0];
   vector_map::Point coarse_p2 = coarse_points[1];
 
-  vector_map::Point nearest_point = find_nearest_point(lane_vmap, coarse_p1);
+  vector_map::Point nearest_point = find_nearest_point(lane_vmap, index, coarse_p1);
   if (nearest_point.pid < 0)
     return nearest_point;
 
-  std::vector<vector_map::Point> near_points = find_near_points(lane_vmap, coarse_p1, search_radius);
+  std::vector<vector_map::Point> near_points = find_near_points(lane_vmap, index, coarse_p1, search_radius);
   double coarse_angle = compute_direction_angle(coarse_p1, coarse_p2);
   double score = 180 + search_radius; // XXX better way?
   for (const vector_map::Point& p1 : near_points) {
-    vector_map::Lane l = find_lane(lane_vmap, lno, p1);
+    vector_map::Lane l = find_lane(lane_vmap, index, lno, p1);
     if (l.lnid < 0)
       continue;
 
-    vector_map::Point p2 = find_end_point(lane_vmap, l);
+    vector_map::Point p2 = find_end_point(lane_vmap, index, l);
     if (p2.pid < 0)
       continue;
 
@@ -189,30 +319,30 @@ vector_map::Point find_departure_point(const VectorMap& lane_vmap, int lno,
   return nearest_point;
 }
 
-vector_map::Point find_arrival_point(const VectorMap& lane_vmap, int lno,
+vector_map::Point find_arrival_point(const VectorMap& lane_vmap, const VectorMapIndex& index, int lno,
              const std::vector<vector_map::Point>& coarse_points,
              double search_radius)
 {
   vector_map::Point coarse_p1 = coarse_points[coarse_points.size() - 1];
   vector_map::Point coarse_p2 = coarse_points[coarse_points.size() - 2];
 
-  vector_map::Point nearest_point = find_nearest_point(lane_vmap, coarse_p1);
+  vector_map::Point nearest_point = find_nearest_point(lane_vmap, index, coarse_p1);
   if (nearest_point.pid < 0)
     return nearest_point;
 
-  std::vector<vector_map::Point> near_points = find_near_points(lane_vmap, coarse_p1, search_radius);
+  std::vector<vector_map::Point> near_points = find_near_points(lane_vmap, index, coarse_p1, search_radius);
   double coarse_angle = compute_direction_angle(coarse_p1, coarse_p2);
   double score = 180 + search_radius; // XXX better way?
   for (const vector_map::Point& p1 : near_points) {
-    vector_map::Lane l = find_lane(lane_vmap, lno, p1);
+    vector_map::Lane l = find_lane(lane_vmap, index, lno, p1);
     if (l.lnid < 0)
       continue;
 
-    l = find_prev_lane(lane_vmap, lno, l);
+    l = find_prev_lane(lane_vmap, index, lno, l);
     if (l.lnid < 0)
       continue;
 
-    vector_map::Point p2 = find_start_point(lane_vmap, l);
+    vector_map::Point p2 = find_start_point(lane_vmap, index, l);
     if (p2.pid < 0)
       continue;
 
@@ -231,74 +361,118 @@ vector_map::Point find_arrival_point(const VectorMap& lane_vmap, int lno,
   return nearest_point;
 }
 
-vector_map::Point find_nearest_point(const VectorMap& vmap, const vector_map::Point& point)
+vector_map::Point find_nearest_point(const VectorMap& vmap, const VectorMapIndex& index,
+             const vector_map::Point& point)
 {
   vector_map::Point nearest_point;
   nearest_point.pid = -1;
 
+  if (index.cells.empty() || !std::isfinite(point.bx) || !std::isfinite(point.ly))
+    return nearest_point;
+
+  // Visit rings of cells around the query until no cell left can hold a nearer point. A point in ring r is at
+  // least (r - 1) cells away. Ties go to the latest point, as in a linear scan with <=.
+  int ix = to_cell(point.bx);
+  int iy = to_cell(point.ly);
+  int r_begin = std::max({ index.min_ix - ix, ix - index.max_ix, index.min_iy - iy, iy - index.max_iy, 0 });
+  int r_end = std::max({ ix - index.min_ix, index.max_ix - ix, iy - index.min_iy, index.max_iy - iy });
+  size_t nearest_index = SIZE_MAX;
   double distance = DBL_MAX;
-  for (const vector_map::Point& p : vmap.points) {
-    double d = hypot(p.bx - point.bx, p.ly - point.ly);
-    if (d <= distance) {
-      nearest_point = p;
-      distance = d;
+  for (int r = r_begin; r <= r_end; ++r) {
+    for (int y = std::max(iy - r, index.min_iy); y <= std::min(iy + r, index.max_iy); ++y) {
+      bool edge = (y == iy - r || y == iy + r);
+      int x_begin = edge ? std::max(ix - r, index.min_ix) : ix - r;
+      int x_end = edge ? std::min(ix + r, index.max_ix) : ix + r;
+      int x_step = edge ? 1 : 2 * r;
+      for (int x = x_begin; x <= x_end; x += x_step) {
+        if (x < index.min_ix || x > index.max_ix)
+          continue;
+        std::unordered_map<int64_t, std::vector<size_t>>::const_iterator cell = index.cells.find(to_cell_key(x, y));
+        if (cell == index.cells.end())
+          continue;
+        for (size_t i : cell->second) {
+          const vector_map::Point& p = vmap.points[i];
+          double d = hypot(p.bx - point.bx, p.ly - point.ly);
+          if (d < distance || (d == distance && i > nearest_index)) {
+            nearest_index = i;
+            distance = d;
+          }
+        }
+      }
     }
+    if (nearest_index != SIZE_MAX && distance < r * INDEX_CELL_SIZE)
+      break;
   }
 
+  if (nearest_index != SIZE_MAX)
+    nearest_point = vmap.points[nearest_index];
+
   return nearest_point;
 }
 
-std::vector<vector_map::Point> find_near_points(const VectorMap& vmap, const vector_map::Point& point,
-            double search_radius)
+std::vector<vector_map::Point> find_near_points(const VectorMap& vmap, const VectorMapIndex& index,
+            const vector_map::Point& point, double search_radius)
 {
   std::vector<vector_map::Point> near_points;
-  for (const vector_map::Point& p : vmap.points) {
-    double d = hypot(p.bx - point.bx, p.ly - point.ly);
-    if (d <= search_radius)
-      near_points.push_back(p);
+  if (index.cells.empty() || !std::isfinite(point.bx) || !std::isfinite(point.ly) || !(search_radius >= 0))
+    return near_points;
+
+  int x_begin = to_clamped_cell(point.bx - search_radius, index.min_ix, index.max_ix);
+  int x_end = to_clamped_cell(point.bx + search_radius, index.min_ix, index.max_ix);
+  int y_begin = to_clamped_cell(point.ly - search_radius, index.min_iy, index.max_iy);
+  int y_end = to_clamped_cell(point.ly + search_radius, index.min_iy, index.max_iy);
+  std::vector<size_t> near_indexes;
+  for (int y = y_begin; y <= y_end; ++y) {
+    for (int x = x_begin; x <= x_end; ++x) {
+      std::unordered_map<int64_t, std::vector<size_t>>::const_iterator cell = index.cells.find(to_cell_key(x, y));
+      if (cell == index.cells.end())
+        continue;
+      for (size_t i : cell->second) {
+        const vector_map::Point& p = vmap.points[i];
+        double d = hypot(p.bx - point.bx, p.ly - point.ly);
+        if (d <= search_radius)
+          near_indexes.push_back(i);
+      }
+    }
   }
 
+  // keep the order of vmap.points
+  std::sort(near_indexes.begin(), near_indexes.end());
+  near_points.reserve(near_indexes.size());
+  for (size_t i : near_indexes)
+    near_points.push_back(vmap.points[i]);
+
   return near_points;
 }
 
-vector_map::Lane find_lane(const VectorMap& vmap, int lno, const vector_map::Point& point)
+// position of the first lane in vmap.lanes which has one of lnids, or SIZE_MAX
+size_t find_first_lane_index(const VectorMap& vmap, const VectorMapIndex& index, int lno,
+           std::initializer_list<int> lnids)
 {
-  vector_map::Lane error;
-  error.lnid = -1;
-
-  for (const vector_map::Node& n : vmap.nodes) {
-    if (n.pid != point.pid)
-      continue;
-    for (const vector_map::Lane& l : vmap.lanes) {
-      if (lno != LNO_ALL && l.lno != lno)
-        continue;
-      if (l.bnid != n.nid)
+  size_t first = SIZE_MAX;
+  for (int lnid : lnids) {
+    for (size_t i : find_ids(index.lanes_by_lnid, lnid)) {
+      if (lno != LNO_ALL && vmap.lanes[i].lno != lno)
         continue;
-      return l;
+      first = std::min(first, i);
+      break;
     }
   }
 
-  return error;
+  return first;
 }
 
-vector_map::Lane find_prev_lane(const VectorMap& vmap, int lno, const vector_map::Lane& lane)
+vector_map::Lane find_lane(const VectorMap& vmap, const VectorMapIndex& index, int lno,
+         const vector_map::Point& point)
 {
   vector_map::Lane error;
   error.lnid = -1;
 
-  if (is_merging_lane(lane)) {
-    for (const vector_map::Lane& l : vmap.lanes) {
+  for (size_t n : find_ids(index.nodes_by_pid, point.pid)) {
+    for (size_t i : find_ids(index.lanes_by_bnid, vmap.nodes[n].nid)) {
+      const vector_map::Lane& l = vmap.lanes[i];
       if (lno != LNO_ALL && l.lno != lno)
         continue;
-      if (l.lnid != lane.blid && l.lnid != lane.blid2 && l.lnid != lane.blid3 &&
-          l.lnid != lane.blid4)
-        continue;
-      return l;
-    }
-  } else {
-    for (const vector_map::Lane& l : vmap.lanes) {
-      if (l.lnid != lane.blid)
-        continue;
       return l;
     }
   }
@@ -306,64 +480,80 @@ vector_map::Lane find_prev_lane(const VectorMap& vmap, int lno, const vector_map
   return error;
 }
 
-vector_map::Lane find_next_lane(const VectorMap& vmap, int lno, const vector_map::Lane& lane)
+vector_map::Lane find_prev_lane(const VectorMap& vmap, const VectorMapIndex& index, int lno,
+        const vector_map::Lane& lane)
 {
   vector_map::Lane error;
   error.lnid = -1;
 
-  if (is_branching_lane(lane)) {
-    for (const vector_map::Lane& l : vmap.lanes) {
-      if (lno != LNO_ALL && l.lno != lno)
-        continue;
-      if (l.lnid != lane.flid && l.lnid != lane.flid2 && l.lnid != lane.flid3 &&
-          l.lnid != lane.flid4)
-        continue;
-      return l;
-    }
-  } else {
-    for (const vector_map::Lane& l : vmap.lanes) {
-      if (l.lnid != lane.flid)
-        continue;
-      return l;
-    }
-  }
+  size_t i;
+  if (is_merging_lane(lane))
+    i = find_first_lane_index(vmap, index, lno, { lane.blid, lane.blid2, lane.blid3, lane.blid4 });
+  else
+    i = find_first_lane_index(vmap, index, LNO_ALL, { lane.blid });
+  if (i == SIZE_MAX)
+    return error;
 
-  return error;
+  return vmap.lanes[i];
+}
+
+vector_map::Lane find_next_lane(const VectorMap& vmap, const VectorMapIndex& index, int lno,
+        const vector_map::Lane& lane)
+{
+  vector_map::Lane error;
+  error.lnid = -1;
+
+  size_t i;
+  if (is_branching_lane(lane))
+    i = find_first_lane_index(vmap, index, lno, { lane.flid, lane.flid2, lane.flid3, lane.flid4 });
+  else
+    i = find_first_lane_index(vmap, index, LNO_ALL, { lane.flid });
+  if (i == SIZE_MAX)
+    return error;
+
+  return vmap.lanes[i];
 }
 
-vector_map::Lane find_next_branching_lane(const VectorMap& vmap, int lno, const vector_map::Lane& lane,
-            double coarse_angle, double search_radius)
+vector_map::Lane find_next_branching_lane(const VectorMap& vmap, const VectorMapIndex& index, int lno,
+            const vector_map::Lane& lane, double coarse_angle, double search_radius)
 {
   vector_map::Lane error;
   error.lnid = -1;
 
-  vector_map::Point p1 = find_end_point(vmap, lane);
+  vector_map::Point p1 = find_end_point(vmap, index, lane);
   if (p1.pid < 0)
     return error;
 
+  std::vector<size_t> lane_indexes;
+  for (int lnid : { lane.flid, lane.flid2, lane.flid3, lane.flid4 }) {
+    const std::vector<size_t>& ids = find_ids(index.lanes_by_lnid, lnid);
+    lane_indexes.insert(lane_indexes.end(), ids.begin(), ids.end());
+  }
+  std::sort(lane_indexes.begin(), lane_indexes.end());
+  lane_indexes.erase(std::unique(lane_indexes.begin(), lane_indexes.end()), lane_indexes.end());
+
   std::vector<std::tuple<vector_map::Point, vector_map::Lane>> candidates;
-  for (const vector_map::Lane& l1 : vmap.lanes) {
+  for (size_t i : lane_indexes) {
+    const vector_map::Lane& l1 = vmap.lanes[i];
     if (lno != LNO_ALL && l1.lno != lno)
       continue;
-    if (l1.lnid == lane.flid || l1.lnid == lane.flid2 || l1.lnid == lane.flid3 || l1.lnid == lane.flid4) {
-      vector_map::Lane l2 = l1;
-      vector_map::Point p = find_end_point(vmap, l2);
+    vector_map::Lane l2 = l1;
+    vector_map::Point p = find_end_point(vmap, index, l2);
+    if (p.pid < 0)
+      continue;
+    vector_map::Point p2 = p;
+    double d = hypot(p2.bx - p1.bx, p2.ly - p1.ly);
+    while (d <= search_radius && l2.flid != 0 && !is_branching_lane(l2)) {
+      l2 = find_next_lane(vmap, index, LNO_ALL, l2);
+      if (l2.lnid < 0)
+        break;
+      p = find_end_point(vmap, index, l2);
       if (p.pid < 0)
-        continue;
-      vector_map::Point p2 = p;
-      double d = hypot(p2.bx - p1.bx, p2.ly - p1.ly);
-      while (d <= search_radius && l2.flid != 0 && !is_branching_lane(l2)) {
-        l2 = find_next_lane(vmap, LNO_ALL, l2);
-        if (l2.lnid < 0)
-          break;
-        p = find_end_point(vmap, l2);
-        if (p.pid < 0)
-          break;
-        p2 = p;
-        d = hypot(p2.bx - p1.bx, p2.ly - p1.ly);
-      }
-      candidates.push_back(std::make_tuple(p2, l1));
+        break;
+      p2 = p;
+      d = hypot(p2.bx - p1.bx, p2.ly - p1.ly);
     }
+    candidates.push_back(std::make_tuple(p2, l1));
   }
 
   if (candidates.empty())
@@ -524,37 +714,41 @@ vector_map::DTLane create_vector_map_dtlane(const autoware_msgs::DTLane& wd)
 
 VectorMap create_lane_vmap(const VectorMap& vmap, int lno)
 {
+  std::shared_ptr<const VectorMapIndex> index = get_index(vmap);
+
   VectorMap lane_vmap;
+  std::vector<size_t> node_indexes;
   for (const vector_map::Lane& l : vmap.lanes) {
     if (lno != LNO_ALL && l.lno != lno)
       continue;
     lane_vmap.lanes.push_back(l);
 
-    for (const vector_map::Node& n : vmap.nodes) {
-      if (n.nid != l.bnid && n.nid != l.fnid)
-        continue;
-      lane_vmap.nodes.push_back(n);
-
-      for (const vector_map::Point& p : vmap.points) {
-        if (p.pid != n.pid)
-          continue;
-        lane_vmap.points.push_back(p);
-      }
+    // nodes of both ends, in the order of vmap.nodes
+    const std::vector<size_t>& bnodes = find_ids(index->nodes_by_nid, l.bnid);
+    const std::vector<size_t>& fnodes = find_ids(index->nodes_by_nid, l.fnid);
+    node_indexes.clear();
+    if (l.bnid == l.fnid)
+      node_indexes = bnodes;
+    else
+      std::merge(bnodes.begin(), bnodes.end(), fnodes.begin(), fnodes.end(), std::back_inserter(node_indexes));
+
+    for (size_t n : node_indexes) {
+      const vector_map::Node& node = vmap.nodes[n];
+      lane_vmap.nodes.push_back(node);
+
+      for (size_t p : find_ids(index->points_by_pid, node.pid))
+        lane_vmap.points.push_back(vmap.points[p]);
     }
 
-    for (const vector_map::StopLine& s : vmap.stoplines) {
-      if (s.linkid != l.lnid)
-        continue;
-      lane_vmap.stoplines.push_back(s);
-    }
+    for (size_t s : find_ids(index->stoplines_by_linkid, l.lnid))
+      lane_vmap.stoplines.push_back(vmap.stoplines[s]);
 
-    for (const vector_map::DTLane& d : vmap.dtlanes) {
-      if (d.did != l.did)
-        continue;
-      lane_vmap.dtlanes.push_back(d);
-    }
+    for (size_t d : find_ids(index->dtlanes_by_did, l.did))
+      lane_vmap.dtlanes.push_back(vmap.dtlanes[d]);
   }
 
+  lane_vmap.index = build_index(lane_vmap);
+
   return lane_vmap;
 }
 
@@ -591,13 +785,16 @@ VectorMap create_fine_vmap(const VectorMap& lane_vmap, int lno, const VectorMap&
   VectorMap fine_vmap;
   VectorMap null_vmap;
 
+  std::shared_ptr<const VectorMapIndex> lane_index = get_index(lane_vmap);
+  std::shared_ptr<const VectorMapIndex> coarse_index = get_index(coarse_vmap);
+
   vector_map::Point departure_point;
   departure_point.pid = -1;
   if (lno == LNO_ALL)
-    departure_point = find_nearest_point(lane_vmap, coarse_vmap.points.front());
+    departure_point = find_nearest_point(lane_vmap, *lane_index, coarse_vmap.points.front());
   else {
     for (int i = lno; i >= LNO_CROSSING; --i) {
-      departure_point = find_departure_point(lane_vmap, i, coarse_vmap.points, search_radius);
+      departure_point = find_departure_point(lane_vmap, *lane_index, i, coarse_vmap.points, search_radius);
       if (departure_point.pid >= 0)
         break;
     }
@@ -608,10 +805,10 @@ VectorMap create_fine_vmap(const VectorMap& lane_vmap, int lno, const VectorMap&
   vector_map::Point arrival_point;
   arrival_point.pid = -1;
   if (lno == LNO_ALL)
-    arrival_point = find_nearest_point(lane_vmap, coarse_vmap.points.back());
+    arrival_point = find_nearest_point(lane_vmap, *lane_index, coarse_vmap.points.back());
   else {
     for (int i = lno; i >= LNO_CROSSING; --i) {
-      arrival_point = find_arrival_point(lane_vmap, i, coarse_vmap.points, search_radius);
+      arrival_point = find_arrival_point(lane_vmap, *lane_index, i, coarse_vmap.points, search_radius);
       if (arrival_point.pid >= 0)
         break;
     }
@@ -620,7 +817,7 @@ VectorMap create_fine_vmap(const VectorMap& lane_vmap, int lno, const VectorMap&
     return null_vmap;
 
   vector_map::Point point = departure_point;
-  vector_map::Lane lane = find_lane(lane_vmap, LNO_ALL, point);
+  vector_map::Lane lane = find_lane(lane_vmap, *lane_index, LNO_ALL, point);
   if (lane.lnid < 0)
     return null_vmap;
 
@@ -631,23 +828,17 @@ VectorMap create_fine_vmap(const VectorMap& lane_vmap, int lno, const VectorMap&
     // last is equal to previous dtlane
     vector_map::DTLane dtlane;
     dtlane.did = -1;
-    for (const vector_map::DTLane& d : lane_vmap.dtlanes) {
-      if (d.did == lane.did) {
-        dtlane = d;
-        break;
-      }
-    }
+    const std::vector<size_t>& dtlane_indexes = find_ids(lane_index->dtlanes_by_did, lane.did);
+    if (!dtlane_indexes.empty())
+      dtlane = lane_vmap.dtlanes[dtlane_indexes.front()];
     fine_vmap.dtlanes.push_back(dtlane);
 
     // last is equal to previous stopline
     vector_map::StopLine stopline;
     stopline.id = -1;
-    for (const vector_map::StopLine& s : lane_vmap.stoplines) {
-      if (s.linkid == lane.lnid) {
-        stopline = s;
-        break;
-      }
-    }
+    const std::vector<size_t>& stopline_indexes = find_ids(lane_index->stoplines_by_linkid, lane.lnid);
+    if (!stopline_indexes.empty())
+      stopline = lane_vmap.stoplines[stopline_indexes.front()];
     fine_vmap.stoplines.push_back(stopline);
 
     if (finish)
@@ -655,7 +846,7 @@ VectorMap create_fine_vmap(const VectorMap& lane_vmap, int lno, const VectorMap&
 
     fine_vmap.lanes.push_back(lane);
 
-    point = find_end_point(lane_vmap, lane);
+    point = find_end_point(lane_vmap, *lane_index, lane);
     if (point.pid < 0)
       return null_vmap;
     if (point.bx == arrival_point.bx && point.ly == arrival_point.ly) {
@@ -664,11 +855,11 @@ VectorMap create_fine_vmap(const VectorMap& lane_vmap, int lno, const VectorMap&
     }
 
     if (is_branching_lane(lane)) {
-      vector_map::Point coarse_p1 = find_end_point(lane_vmap, lane);
+      vector_map::Point coarse_p1 = find_end_point(lane_vmap, *lane_index, lane);
       if (coarse_p1.pid < 0)
         return null_vmap;
 
-      coarse_p1 = find_nearest_point(coarse_vmap, coarse_p1);
+      coarse_p1 = find_nearest_point(coarse_vmap, *coarse_index, coarse_p1);
       if (coarse_p1.pid < 0)
         return null_vmap;
 
@@ -690,19 +881,19 @@ VectorMap create_fine_vmap(const VectorMap& lane_vmap, int lno, const VectorMap&
 
       double coarse_angle = compute_direction_angle(coarse_p1, coarse_p2);
       if (lno == LNO_ALL) {
-        lane = find_next_branching_lane(lane_vmap, LNO_ALL, lane, coarse_angle, search_radius);
+        lane = find_next_branching_lane(lane_vmap, *lane_index, LNO_ALL, lane, coarse_angle, search_radius);
       } else {
         vector_map::Lane l;
         l.lnid = -1;
         for (int j = lno; j >= LNO_CROSSING; --j) {
-          l = find_next_branching_lane(lane_vmap, j, lane, coarse_angle, search_radius);
+          l = find_next_branching_lane(lane_vmap, *lane_index, j, lane, coarse_angle, search_radius);
           if (l.lnid >= 0)
             break;
         }
         lane = l;
       }
     } else {
-      lane = find_next_lane(lane_vmap, LNO_ALL, lane);
+      lane = find_next_lane(lane_vmap, *lane_index, LNO_ALL, lane);
     }
     if (lane.lnid < 0)
       return null_vmap;
@@ -718,9 +909,11 @@ VectorMap create_fine_vmap(const VectorMap& lane_vmap, int lno, const VectorMap&
 
 std::vector<vector_map::Point> create_branching_points(const VectorMap& vmap)
 {
+  std::shared_ptr<const VectorMapIndex> index = get_index(vmap);
+
   std::vector<vector_map::Point> branching_points;
   for (const vector_map::Point& p : vmap.points) {
-    if (!is_branching_point(vmap, p))
+    if (!is_branching_point(vmap, *index, p))
       continue;
     branching_points.push_back(p);
   }
@@ -730,9 +923,11 @@ std::vector<vector_map::Point> create_branching_points(const VectorMap& vmap)
 
 std::vector<vector_map::Point> create_merging_points(const VectorMap& vmap)
 {
+  std::shared_ptr<const VectorMapIndex> index = get_index(vmap);
+
   std::vector<vector_map::Point> merging_points;
   for (const vector_map::Point& p : vmap.points) {
-    if (!is_merging_point(vmap, p))
+    if (!is_merging_point(vmap, *index, p))
       continue;
     merging_points.push_back(p);
   }
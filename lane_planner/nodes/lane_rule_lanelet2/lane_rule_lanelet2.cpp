@@ -42,6 +42,8 @@
 #include <autoware_msgs/LaneArray.h>
 #include <autoware_msgs/Waypoint.h>
 
+#include "lane_rule_lanelet2_stopline.h"
+
 // use of routing graph in detecting lanelets for each waypoint
 // folowing routing graph may be computationally cheaper if very large map
 // (computation cost may be in unique insert used to store connected lanelets)
@@ -64,6 +66,7 @@ static autoware_msgs::LaneArray g_cached_waypoint;
 static lanelet::LaneletMapPtr g_lanelet_map;
 static lanelet::routing::RoutingGraphPtr g_routing_graph;
 static bool g_loaded_lanelet_map = false;
+static lane_planner::StopLineRTree g_stopline_rtree;
 
 // create new lane with given lane and header
 autoware_msgs::Lane create_new_lane(const autoware_msgs::Lane& lane, const std_msgs::Header& header)
@@ -169,8 +172,6 @@ std::vector<size_t> check_waypoints_for_stoplines(const std::vector<Eigen::Vecto
   // perhaps need to test boundary condition when waypoint is last in lanelet?
   for (auto wp_i = waypoints.begin(); wp_i < waypoints.end() - 1; wp_i++)
   {
-    lanelet::Point3d wp_p0(lanelet::utils::getId(), (*wp_i).x(), (*wp_i).y(), (*wp_i).z());
-    lanelet::Point3d wp_p1(lanelet::utils::getId(),(*(wp_i + 1)).x(), (*(wp_i + 1)).y(), (*(wp_i + 1)).z());
     lanelet::BasicPoint2d wp_p02((*wp_i).x(), (*wp_i).y());
     lanelet::ConstLanelets candidate_lanelets;
 
@@ -194,23 +195,9 @@ std::vector<size_t> check_waypoints_for_stoplines(const std::vector<Eigen::Vecto
       }
       else
       {
-        std::vector<lanelet::ConstLineString3d> current_lanelet_stoplines =
-            lanelet::utils::query::getTrafficLightStopLines(current_lanelet);
-
-        // check if waypoint segment intersects with stoplines
-        // kinda awkward to force use of boost::geometry intersect.
-        // 3d line segment intersection not implememented
-        lanelet::ConstLineString3d wp_ls(lanelet::utils::getId(), { wp_p0, wp_p1 });
-        auto wp_ls2d = lanelet::utils::to2D(wp_ls);
-
-        for (auto sl_i = current_lanelet_stoplines.begin(); sl_i < current_lanelet_stoplines.end(); sl_i++)
-        {
-          auto sl_ls2d = lanelet::utils::to2D(*sl_i);
-          if (lanelet::geometry::intersects(lanelet::utils::toHybrid(wp_ls2d), lanelet::utils::toHybrid(sl_ls2d)))
-          {
-            waypoint_stopline_indexes.push_back(wp_index);
-          }
-        }
+        // check if waypoint segment intersects with stoplines of current lanelet
+        const size_t stopline_count = g_stopline_rtree.countIntersections(current_lanelet.id(), *wp_i, *(wp_i + 1));
+        waypoint_stopline_indexes.insert(waypoint_stopline_indexes.end(), stopline_count, wp_index);
 
         // build up a list of possible connecting lanelets that might contain current waypoint
         if (LANE_RULES_USE_ROUTING_GRAPH)
@@ -394,6 +381,7 @@ void binMapCallback(const autoware_lanelet2_msgs::MapBin& msg)
   g_lanelet_map = std::make_shared<lanelet::LaneletMap>();
 
   lanelet::utils::conversion::fromBinMsg(msg, g_lanelet_map);
+  g_stopline_rtree.build(g_lanelet_map);
   g_loaded_lanelet_map = true;
   ROS_INFO("loaded lanelet map\n");
 
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lane_rule_lanelet2_stopline.h"
+
+#include <lanelet2_extension/utility/query.h>
+
+#include <algorithm>
+
+namespace lane_planner
+{
+void StopLineRTree::build(const lanelet::LaneletMapPtr& map)
+{
+  stoplines_.clear();
+  for (const lanelet::ConstLanelet& ll : map->laneletLayer)
+  {
+    std::vector<lanelet::ConstLineString3d> stoplines = lanelet::utils::query::getTrafficLightStopLines(ll);
+    for (auto sl_i = stoplines.begin(); sl_i < stoplines.end(); sl_i++)
+    {
+      if (sl_i->empty())
+        continue;
+
+      StopLine stopline;
+      stopline.lanelet_id = ll.id();
+      for (const lanelet::ConstPoint3d& p : *sl_i)
+        stopline.line.push_back(Point(p.x(), p.y()));
+      stoplines_.push_back(stopline);
+    }
+  }
+
+  std::vector<std::pair<Box, size_t> > values;
+  values.reserve(stoplines_.size());
+  for (size_t i = 0; i < stoplines_.size(); ++i)
+  {
+    Box box;
+    boost::geometry::envelope(stoplines_[i].line, box);
+    values.push_back(std::make_pair(box, i));
+  }
+
+  // packing construction
+  rtree_ = decltype(rtree_)(values.begin(), values.end());
+}
+
+size_t StopLineRTree::countIntersections(const lanelet::Id lanelet_id, const Eigen::Vector3d& p0,
+                                         const Eigen::Vector3d& p1) const
+{
+  // boxes are closed, so segments ending exactly on a stopline are kept
+  const Box box(Point(std::min(p0.x(), p1.x()), std::min(p0.y(), p1.y())),
+                Point(std::max(p0.x(), p1.x()), std::max(p0.y(), p1.y())));
+
+  size_t count = 0;
+  LineString segment;
+  for (auto sl_i = rtree_.qbegin(boost::geometry::index::intersects(box)); sl_i != rtree_.qend(); sl_i++)
+  {
+    const StopLine& stopline = stoplines_[sl_i->second];
+    if (stopline.lanelet_id != lanelet_id)
+      continue;
+
+    if (segment.empty())
+    {
+      segment.push_back(Point(p0.x(), p0.y()));
+      segment.push_back(Point(p1.x(), p1.y()));
+    }
+    if (boost::geometry::intersects(segment, stopline.line))
+      count++;
+  }
+  return count;
+}
+}  // namespace lane_planner
@@ -17,6 +17,7 @@
 #include "lane_select_core.h"
 
 #include <algorithm>
+#include <cfloat>
 
 namespace lane_planner
 {
@@ -787,6 +788,19 @@ double getRelativeAngle(const geometry_msgs::Pose &waypoint_pose, const geometry
   return current_v.angle(waypoint_v) * 180 / M_PI;
 }
 
+// get heading of orientation projected on the xy plane, not normalized
+geometry_msgs::Vector3 getPlanarHeading(const geometry_msgs::Quaternion &orientation)
+{
+  // first column of the rotation matrix, without its z element
+  const double s = 2.0 / (orientation.x * orientation.x + orientation.y * orientation.y +
+                          orientation.z * orientation.z + orientation.w * orientation.w);
+  geometry_msgs::Vector3 heading;
+  heading.x = 1.0 - s * (orientation.y * orientation.y + orientation.z * orientation.z);
+  heading.y = s * (orientation.x * orientation.y + orientation.w * orientation.z);
+  heading.z = 0.0;
+  return heading;
+}
+
 // get closest waypoint from current pose
 int32_t getClosestWaypointNumber(const autoware_msgs::Lane &current_lane, const geometry_msgs::Pose &current_pose,
                                  const geometry_msgs::Twist &current_velocity, const int32_t previous_number,
@@ -795,15 +809,11 @@ int32_t getClosestWaypointNumber(const autoware_msgs::Lane &current_lane, const
   if (current_lane.waypoints.size() < 2)
     return -1;
 
-  std::vector<uint32_t> idx_vec;
   // if previous number is -1, search closest waypoint from waypoints in front of current pose
+  // otherwise, search around the previous number
   uint32_t range_min = 0;
   uint32_t range_max = current_lane.waypoints.size() - 1;
-  if (previous_number == -1)
-  {
-    idx_vec.reserve(current_lane.waypoints.size());
-  }
-  else
+  if (previous_number != -1)
   {
     if (distance_threshold <
         getTwoDimensionalDistance(current_lane.waypoints.at(previous_number).pose.pose.position, current_pose.position))
@@ -811,7 +821,10 @@ int32_t getClosestWaypointNumber(const autoware_msgs::Lane &current_lane, const
       ROS_WARN("Current_pose is far away from previous closest waypoint. Initilized...");
       return -1;
     }
-    range_min = static_cast<uint32_t>(previous_number);
+    if (previous_number > search_closest_waypoint_minimum_dt)
+    {
+      range_min = static_cast<uint32_t>(previous_number - search_closest_waypoint_minimum_dt);
+    }
     double ratio = 3;
     double dt = std::max(current_velocity.linear.x * ratio, static_cast<double>(search_closest_waypoint_minimum_dt));
     if (static_cast<uint32_t>(previous_number + dt) < current_lane.waypoints.size())
@@ -821,29 +834,32 @@ int32_t getClosestWaypointNumber(const autoware_msgs::Lane &current_lane, const
   }
   const LaneDirection dir = getLaneDirection(current_lane);
   const int sgn = (dir == LaneDirection::Forward) ? 1 : (dir == LaneDirection::Backward) ? -1 : 0;
+
+  // candidates are in front of current pose and head less than 90 degrees apart from it
+  // (a degenerate quaternion gives NaN heading, which fails both tests below)
+  const geometry_msgs::Vector3 current_heading = getPlanarHeading(current_pose.orientation);
+  int32_t found_number = -1;
+  double min_squared_dist = DBL_MAX;
   for (uint32_t i = range_min; i <= range_max; i++)
   {
-    geometry_msgs::Point converted_p =
-      convertPointIntoRelativeCoordinate(current_lane.waypoints.at(i).pose.pose.position, current_pose);
-    double angle = getRelativeAngle(current_lane.waypoints.at(i).pose.pose, current_pose);
-    if (converted_p.x * sgn > 0 && angle < 90)
+    const geometry_msgs::Pose &waypoint_pose = current_lane.waypoints.at(i).pose.pose;
+    const double dx = waypoint_pose.position.x - current_pose.position.x;
+    const double dy = waypoint_pose.position.y - current_pose.position.y;
+    if (!((dx * current_heading.x + dy * current_heading.y) * sgn > 0))
+      continue;
+
+    const geometry_msgs::Vector3 heading = getPlanarHeading(waypoint_pose.orientation);
+    if (!(heading.x * current_heading.x + heading.y * current_heading.y > 0))
+      continue;
+
+    const double squared_dist = dx * dx + dy * dy;
+    if (squared_dist < min_squared_dist)
     {
-      idx_vec.push_back(i);
+      min_squared_dist = squared_dist;
+      found_number = i;
     }
   }
 
-  if (idx_vec.empty())
-    return -1;
-
-  std::vector<double> dist_vec;
-  dist_vec.reserve(idx_vec.size());
-  for (const auto &el : idx_vec)
-  {
-    double dt = getTwoDimensionalDistance(current_pose.position, current_lane.waypoints.at(el).pose.pose.position);
-    dist_vec.push_back(dt);
-  }
-  std::vector<double>::iterator itr = std::min_element(dist_vec.begin(), dist_vec.end());
-  int32_t found_number = idx_vec.at(static_cast<uint32_t>(std::distance(dist_vec.begin(), itr)));
   return found_number;
 }
 
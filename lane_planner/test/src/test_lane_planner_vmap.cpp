@@ -0,0 +1,664 @@
+/*
+ * Copyright 2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <ros/ros.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <lane_planner/lane_planner_vmap.hpp>
+
+namespace lane_planner {
+
+namespace vmap {
+
+// linear scans of lane_planner_vmap before VectorMapIndex, used as reference
+namespace linear {
+
+double compute_direction_angle(const vector_map::Point& p1, const vector_map::Point& p2)
+{
+  return (atan2(p2.ly - p1.ly, p2.bx - p1.bx) * (180 / M_PI));
+}
+
+bool is_branching_lane(const vector_map::Lane& lane)
+{
+  return (lane.jct == 1 || lane.jct == 2 || lane.jct == 5);
+}
+
+bool is_merging_lane(const vector_map::Lane& lane)
+{
+  return (lane.jct == 3 || lane.jct == 4 || lane.jct == 5);
+}
+
+vector_map::Point find_end_point(const VectorMap& vmap, int nid)
+{
+  vector_map::Point error;
+  error.pid = -1;
+
+  for (const vector_map::Node& n : vmap.nodes) {
+    if (n.nid != nid)
+      continue;
+    for (const vector_map::Point& p : vmap.points) {
+      if (p.pid != n.pid)
+        continue;
+      return p;
+    }
+  }
+
+  return error;
+}
+
+vector_map::Point find_nearest_point(const VectorMap& vmap, const vector_map::Point& point)
+{
+  vector_map::Point nearest_point;
+  nearest_point.pid = -1;
+
+  double distance = DBL_MAX;
+  for (const vector_map::Point& p : vmap.points) {
+    double d = hypot(p.bx - point.bx, p.ly - point.ly);
+    if (d <= distance) {
+      nearest_point = p;
+      distance = d;
+    }
+  }
+
+  return nearest_point;
+}
+
+std::vector<vector_map::Point> find_near_points(const VectorMap& vmap, const vector_map::Point& point,
+            double search_radius)
+{
+  std::vector<vector_map::Point> near_points;
+  for (const vector_map::Point& p : vmap.points) {
+    double d = hypot(p.bx - point.bx, p.ly - point.ly);
+    if (d <= search_radius)
+      near_points.push_back(p);
+  }
+
+  return near_points;
+}
+
+vector_map::Lane find_lane(const VectorMap& vmap, int lno, const vector_map::Point& point)
+{
+  vector_map::Lane error;
+  error.lnid = -1;
+
+  for (const vector_map::Node& n : vmap.nodes) {
+    if (n.pid != point.pid)
+      continue;
+    for (const vector_map::Lane& l : vmap.lanes) {
+      if (lno != LNO_ALL && l.lno != lno)
+        continue;
+      if (l.bnid != n.nid)
+        continue;
+      return l;
+    }
+  }
+
+  return error;
+}
+
+vector_map::Lane find_prev_lane(const VectorMap& vmap, int lno, const vector_map::Lane& lane)
+{
+  vector_map::Lane error;
+  error.lnid = -1;
+
+  for (const vector_map::Lane& l : vmap.lanes) {
+    if (is_merging_lane(lane)) {
+      if (lno != LNO_ALL && l.lno != lno)
+        continue;
+      if (l.lnid != lane.blid && l.lnid != lane.blid2 && l.lnid != lane.blid3 && l.lnid != lane.blid4)
+        continue;
+    } else if (l.lnid != lane.blid) {
+      continue;
+    }
+    return l;
+  }
+
+  return error;
+}
+
+vector_map::Lane find_next_lane(const VectorMap& vmap, int lno, const vector_map::Lane& lane)
+{
+  vector_map::Lane error;
+  error.lnid = -1;
+
+  for (const vector_map::Lane& l : vmap.lanes) {
+    if (is_branching_lane(lane)) {
+      if (lno != LNO_ALL && l.lno != lno)
+        continue;
+      if (l.lnid != lane.flid && l.lnid != lane.flid2 && l.lnid != lane.flid3 && l.lnid != lane.flid4)
+        continue;
+    } else if (l.lnid != lane.flid) {
+      continue;
+    }
+    return l;
+  }
+
+  return error;
+}
+
+// departure point if arrival is false, arrival point otherwise
+vector_map::Point find_route_point(const VectorMap& lane_vmap, int lno,
+           const std::vector<vector_map::Point>& coarse_points, double search_radius, bool arrival)
+{
+  vector_map::Point coarse_p1 = arrival ? coarse_points[coarse_points.size() - 1] : coarse_points[0];
+  vector_map::Point coarse_p2 = arrival ? coarse_points[coarse_points.size() - 2] : coarse_points[1];
+
+  vector_map::Point nearest_point = find_nearest_point(lane_vmap, coarse_p1);
+  if (nearest_point.pid < 0)
+    return nearest_point;
+
+  double coarse_angle = compute_direction_angle(coarse_p1, coarse_p2);
+  double score = 180 + search_radius;
+  for (const vector_map::Point& p1 : find_near_points(lane_vmap, coarse_p1, search_radius)) {
+    vector_map::Lane l = find_lane(lane_vmap, lno, p1);
+    if (l.lnid < 0)
+      continue;
+
+    if (arrival) {
+      l = find_prev_lane(lane_vmap, lno, l);
+      if (l.lnid < 0)
+        continue;
+    }
+
+    vector_map::Point p2 = find_end_point(lane_vmap, arrival ? l.bnid : l.fnid);
+    if (p2.pid < 0)
+      continue;
+
+    double a = compute_direction_angle(p1, p2);
+    a = fabs(a - coarse_angle);
+    if (a > 180)
+      a = fabs(a - 360);
+    double d = hypot(p1.bx - coarse_p1.bx, p1.ly - coarse_p1.ly);
+    double s = a + d;
+    if (s <= score) {
+      nearest_point = p1;
+      score = s;
+    }
+  }
+
+  return nearest_point;
+}
+
+vector_map::Lane find_next_branching_lane(const VectorMap& vmap, int lno, const vector_map::Lane& lane,
+            double coarse_angle, double search_radius)
+{
+  vector_map::Lane error;
+  error.lnid = -1;
+
+  vector_map::Point p1 = find_end_point(vmap, lane.fnid);
+  if (p1.pid < 0)
+    return error;
+
+  std::vector<std::tuple<vector_map::Point, vector_map::Lane>> candidates;
+  for (const vector_map::Lane& l1 : vmap.lanes) {
+    if (lno != LNO_ALL && l1.lno != lno)
+      continue;
+    if (l1.lnid == lane.flid || l1.lnid == lane.flid2 || l1.lnid == lane.flid3 || l1.lnid == lane.flid4) {
+      vector_map::Lane l2 = l1;
+      vector_map::Point p = find_end_point(vmap, l2.fnid);
+      if (p.pid < 0)
+        continue;
+      vector_map::Point p2 = p;
+      double d = hypot(p2.bx - p1.bx, p2.ly - p1.ly);
+      while (d <= search_radius && l2.flid != 0 && !is_branching_lane(l2)) {
+        l2 = find_next_lane(vmap, LNO_ALL, l2);
+        if (l2.lnid < 0)
+          break;
+        p = find_end_point(vmap, l2.fnid);
+        if (p.pid < 0)
+          break;
+        p2 = p;
+        d = hypot(p2.bx - p1.bx, p2.ly - p1.ly);
+      }
+      candidates.push_back(std::make_tuple(p2, l1));
+    }
+  }
+
+  if (candidates.empty())
+    return error;
+
+  vector_map::Lane branching_lane;
+  double angle = 180;
+  for (const std::tuple<vector_map::Point, vector_map::Lane>& c : candidates) {
+    double a = compute_direction_angle(p1, std::get<0>(c));
+    a = fabs(a - coarse_angle);
+    if (a > 180)
+      a = fabs(a - 360);
+    if (a <= angle) {
+      branching_lane = std::get<1>(c);
+      angle = a;
+    }
+  }
+
+  return branching_lane;
+}
+
+VectorMap create_lane_vmap(const VectorMap& vmap, int lno)
+{
+  VectorMap lane_vmap;
+  for (const vector_map::Lane& l : vmap.lanes) {
+    if (lno != LNO_ALL && l.lno != lno)
+      continue;
+    lane_vmap.lanes.push_back(l);
+
+    for (const vector_map::Node& n : vmap.nodes) {
+      if (n.nid != l.bnid && n.nid != l.fnid)
+        continue;
+      lane_vmap.nodes.push_back(n);
+
+      for (const vector_map::Point& p : vmap.points) {
+        if (p.pid != n.pid)
+          continue;
+        lane_vmap.points.push_back(p);
+      }
+    }
+
+    for (const vector_map::StopLine& s : vmap.stoplines) {
+      if (s.linkid != l.lnid)
+        continue;
+      lane_vmap.stoplines.push_back(s);
+    }
+
+    for (const vector_map::DTLane& d : vmap.dtlanes) {
+      if (d.did != l.did)
+        continue;
+      lane_vmap.dtlanes.push_back(d);
+    }
+  }
+
+  return lane_vmap;
+}
+
+VectorMap create_fine_vmap(const VectorMap& lane_vmap, int lno, const VectorMap& coarse_vmap, double search_radius,
+         int waypoint_max)
+{
+  VectorMap fine_vmap;
+  VectorMap null_vmap;
+
+  vector_map::Point departure_point;
+  departure_point.pid = -1;
+  vector_map::Point arrival_point;
+  arrival_point.pid = -1;
+  if (lno == LNO_ALL) {
+    departure_point = find_nearest_point(lane_vmap, coarse_vmap.points.front());
+    arrival_point = find_nearest_point(lane_vmap, coarse_vmap.points.back());
+  } else {
+    for (int i = lno; i >= LNO_CROSSING && departure_point.pid < 0; --i)
+      departure_point = find_route_point(lane_vmap, i, coarse_vmap.points, search_radius, false);
+    for (int i = lno; i >= LNO_CROSSING && arrival_point.pid < 0; --i)
+      arrival_point = find_route_point(lane_vmap, i, coarse_vmap.points, search_radius, true);
+  }
+  if (departure_point.pid < 0 || arrival_point.pid < 0)
+    return null_vmap;
+
+  vector_map::Point point = departure_point;
+  vector_map::Lane lane = find_lane(lane_vmap, LNO_ALL, point);
+  if (lane.lnid < 0)
+    return null_vmap;
+
+  bool finish = false;
+  for (int i = 0; i < waypoint_max; ++i) {
+    fine_vmap.points.push_back(point);
+
+    vector_map::DTLane dtlane;
+    dtlane.did = -1;
+    for (const vector_map::DTLane& d : lane_vmap.dtlanes) {
+      if (d.did == lane.did) {
+        dtlane = d;
+        break;
+      }
+    }
+    fine_vmap.dtlanes.push_back(dtlane);
+
+    vector_map::StopLine stopline;
+    stopline.id = -1;
+    for (const vector_map::StopLine& s : lane_vmap.stoplines) {
+      if (s.linkid == lane.lnid) {
+        stopline = s;
+        break;
+      }
+    }
+    fine_vmap.stoplines.push_back(stopline);
+
+    if (finish)
+      break;
+
+    fine_vmap.lanes.push_back(lane);
+
+    point = find_end_point(lane_vmap, lane.fnid);
+    if (point.pid < 0)
+      return null_vmap;
+    if (point.bx == arrival_point.bx && point.ly == arrival_point.ly) {
+      finish = true;
+      continue;
+    }
+
+    if (is_branching_lane(lane)) {
+      vector_map::Point coarse_p1 = find_nearest_point(coarse_vmap, point);
+      if (coarse_p1.pid < 0)
+        return null_vmap;
+
+      vector_map::Point coarse_p2;
+      double distance = -1;
+      for (const vector_map::Point& p : coarse_vmap.points) {
+        if (distance == -1) {
+          if (p.bx == coarse_p1.bx && p.ly == coarse_p1.ly)
+            distance = 0;
+          continue;
+        }
+        coarse_p2 = p;
+        distance = hypot(coarse_p2.bx - coarse_p1.bx, coarse_p2.ly - coarse_p1.ly);
+        if (distance > search_radius)
+          break;
+      }
+      if (distance <= 0)
+        return null_vmap;
+
+      double coarse_angle = compute_direction_angle(coarse_p1, coarse_p2);
+      if (lno == LNO_ALL) {
+        lane = find_next_branching_lane(lane_vmap, LNO_ALL, lane, coarse_angle, search_radius);
+      } else {
+        vector_map::Lane l;
+        l.lnid = -1;
+        for (int j = lno; j >= LNO_CROSSING && l.lnid < 0; --j)
+          l = find_next_branching_lane(lane_vmap, j, lane, coarse_angle, search_radius);
+        lane = l;
+      }
+    } else {
+      lane = find_next_lane(lane_vmap, LNO_ALL, lane);
+    }
+    if (lane.lnid < 0)
+      return null_vmap;
+  }
+
+  if (!finish)
+    return null_vmap;
+
+  return fine_vmap;
+}
+
+std::vector<vector_map::Point> create_branching_points(const VectorMap& vmap)
+{
+  std::vector<vector_map::Point> branching_points;
+  for (const vector_map::Point& p : vmap.points) {
+    vector_map::Lane lane = find_lane(vmap, LNO_ALL, p);
+    if (lane.lnid < 0)
+      continue;
+    lane = find_prev_lane(vmap, LNO_ALL, lane);
+    if (lane.lnid < 0 || !is_branching_lane(lane))
+      continue;
+    branching_points.push_back(p);
+  }
+
+  return branching_points;
+}
+
+std::vector<vector_map::Point> create_merging_points(const VectorMap& vmap)
+{
+  std::vector<vector_map::Point> merging_points;
+  for (const vector_map::Point& p : vmap.points) {
+    vector_map::Lane lane = find_lane(vmap, LNO_ALL, p);
+    if (lane.lnid < 0 || !is_merging_lane(lane))
+      continue;
+    merging_points.push_back(p);
+  }
+
+  return merging_points;
+}
+
+} // namespace linear
+
+class LanePlannerVmapTestSuite : public ::testing::Test {
+public:
+  LanePlannerVmapTestSuite() {}
+  ~LanePlannerVmapTestSuite() {}
+
+  // grid road network of rows x cols intersections, with lanes of sub segments along the edges in both
+  // directions, shuffled so that the vector order matters, and some points duplicated
+  VectorMap createGridMap(int rows, int cols, int sub, double spacing, std::mt19937* gen)
+  {
+    VectorMap vmap;
+    int pid = 1;
+    int nid = 1;
+    int lnid = 1;
+    std::uniform_real_distribution<double> jitter(-0.03, 0.03);
+    std::uniform_int_distribution<int> lane_number(1, 2);
+
+    auto add_point = [&](double x, double y) {
+      vector_map::Point p;
+      p.pid = pid++;
+      p.bx = x;
+      p.ly = y;
+      vmap.points.push_back(p);
+      vector_map::Node n;
+      n.nid = nid++;
+      n.pid = p.pid;
+      vmap.nodes.push_back(n);
+      return n.nid;
+    };
+
+    std::vector<int> crossing_nids(rows * cols);
+    for (int r = 0; r < rows; ++r)
+      for (int c = 0; c < cols; ++c)
+        crossing_nids[r * cols + c] = add_point(r * spacing, c * spacing);
+
+    std::vector<std::pair<int, int>> edges;
+    for (int r = 0; r < rows; ++r) {
+      for (int c = 0; c < cols; ++c) {
+        int v = r * cols + c;
+        if (c + 1 < cols) {
+          edges.push_back(std::make_pair(v, v + 1));
+          edges.push_back(std::make_pair(v + 1, v));
+        }
+        if (r + 1 < rows) {
+          edges.push_back(std::make_pair(v, v + cols));
+          edges.push_back(std::make_pair(v + cols, v));
+        }
+      }
+    }
+
+    std::vector<std::vector<int>> out_lnids(rows * cols);
+    std::vector<std::vector<int>> in_lnids(rows * cols);
+    for (const std::pair<int, int>& e : edges) {
+      double ax = (e.first / cols) * spacing;
+      double ay = (e.first % cols) * spacing;
+      double bx = (e.second / cols) * spacing;
+      double by = (e.second % cols) * spacing;
+      int lno = lane_number(*gen);
+      int prev_nid = crossing_nids[e.first];
+      int first = -1;
+      int last = -1;
+      for (int s = 1; s <= sub; ++s) {
+        int next_nid = (s == sub) ? crossing_nids[e.second]
+                                  : add_point(ax + (bx - ax) * s / sub + jitter(*gen),
+                                              ay + (by - ay) * s / sub + jitter(*gen));
+        vector_map::Lane l;
+        l.lnid = lnid++;
+        l.did = l.lnid;
+        l.bnid = prev_nid;
+        l.fnid = next_nid;
+        l.lno = lno;
+        if (last >= 0) {
+          l.blid = last;
+          vmap.lanes[last - 1].flid = l.lnid;
+        }
+        vmap.lanes.push_back(l);
+        if (first < 0)
+          first = l.lnid;
+        last = l.lnid;
+        prev_nid = next_nid;
+
+        vector_map::DTLane d;
+        d.did = l.did;
+        d.r = (s % 3 == 0) ? 30 : RADIUS_MAX;
+        vmap.dtlanes.push_back(d);
+      }
+      out_lnids[e.first].push_back(first);
+      in_lnids[e.second].push_back(last);
+
+      vector_map::StopLine stopline;
+      stopline.id = static_cast<int>(vmap.stoplines.size()) + 1;
+      stopline.linkid = last;
+      vmap.stoplines.push_back(stopline);
+    }
+
+    // connect lanes at the crossings
+    for (int v = 0; v < rows * cols; ++v) {
+      for (int in : in_lnids[v]) {
+        vector_map::Lane& l = vmap.lanes[in - 1];
+        int* flids[] = { &l.flid, &l.flid2, &l.flid3, &l.flid4 };
+        for (size_t k = 0; k < out_lnids[v].size() && k < 4; ++k)
+          *flids[k] = out_lnids[v][k];
+        if (out_lnids[v].size() > 1)
+          l.jct = 1;
+      }
+      for (int out : out_lnids[v]) {
+        vector_map::Lane& l = vmap.lanes[out - 1];
+        int* blids[] = { &l.blid, &l.blid2, &l.blid3, &l.blid4 };
+        for (size_t k = 0; k < in_lnids[v].size() && k < 4; ++k)
+          *blids[k] = in_lnids[v][k];
+        if (in_lnids[v].size() > 1)
+          l.jct = (l.jct == 1) ? 5 : 3;
+      }
+    }
+
+    std::shuffle(vmap.points.begin(), vmap.points.end(), *gen);
+    std::shuffle(vmap.nodes.begin(), vmap.nodes.end(), *gen);
+    std::shuffle(vmap.lanes.begin(), vmap.lanes.end(), *gen);
+    std::shuffle(vmap.dtlanes.begin(), vmap.dtlanes.end(), *gen);
+    for (int i = 0; i < 10; ++i)
+      vmap.points.push_back(vmap.points[(*gen)() % vmap.points.size()]);
+
+    return vmap;
+  }
+
+  void expectEqual(const std::vector<vector_map::Point>& expected, const std::vector<vector_map::Point>& actual)
+  {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(expected[i].pid, actual[i].pid) << "points[" << i << "]";
+      ASSERT_EQ(expected[i].bx, actual[i].bx) << "points[" << i << "]";
+      ASSERT_EQ(expected[i].ly, actual[i].ly) << "points[" << i << "]";
+    }
+  }
+
+  void expectEqual(const VectorMap& expected, const VectorMap& actual)
+  {
+    expectEqual(expected.points, actual.points);
+    ASSERT_EQ(expected.lanes.size(), actual.lanes.size());
+    for (size_t i = 0; i < expected.lanes.size(); ++i)
+      ASSERT_EQ(expected.lanes[i].lnid, actual.lanes[i].lnid) << "lanes[" << i << "]";
+    ASSERT_EQ(expected.nodes.size(), actual.nodes.size());
+    for (size_t i = 0; i < expected.nodes.size(); ++i)
+      ASSERT_EQ(expected.nodes[i].nid, actual.nodes[i].nid) << "nodes[" << i << "]";
+    ASSERT_EQ(expected.stoplines.size(), actual.stoplines.size());
+    for (size_t i = 0; i < expected.stoplines.size(); ++i)
+      ASSERT_EQ(expected.stoplines[i].id, actual.stoplines[i].id) << "stoplines[" << i << "]";
+    ASSERT_EQ(expected.dtlanes.size(), actual.dtlanes.size());
+    for (size_t i = 0; i < expected.dtlanes.size(); ++i)
+      ASSERT_EQ(expected.dtlanes[i].did, actual.dtlanes[i].did) << "dtlanes[" << i << "]";
+  }
+};
+
+TEST_F(LanePlannerVmapTestSuite, createLaneVmap)
+{
+  std::mt19937 gen(0);
+  VectorMap all_vmap = createGridMap(4, 4, 3, 50.0, &gen);
+
+  for (int lno : { LNO_ALL, 1, 2 }) {
+    VectorMap lane_vmap = create_lane_vmap(all_vmap, lno);
+    ASSERT_TRUE(lane_vmap.index != nullptr);
+    expectEqual(linear::create_lane_vmap(all_vmap, lno), lane_vmap);
+  }
+
+  VectorMap lane_vmap = create_lane_vmap(all_vmap, LNO_ALL);
+  VectorMap linear_lane_vmap = linear::create_lane_vmap(all_vmap, LNO_ALL);
+  expectEqual(linear::create_branching_points(linear_lane_vmap), create_branching_points(lane_vmap));
+  expectEqual(linear::create_merging_points(linear_lane_vmap), create_merging_points(lane_vmap));
+}
+
+TEST_F(LanePlannerVmapTestSuite, createFineVmap)
+{
+  std::mt19937 gen(1);
+  VectorMap lane_vmap = create_lane_vmap(createGridMap(4, 4, 3, 50.0, &gen), LNO_ALL);
+  std::uniform_real_distribution<double> position(-20.0, 170.0);
+
+  int found = 0;
+  for (int i = 0; i < 100; ++i) {
+    VectorMap coarse_vmap;
+    int size = 2 + gen() % 5;
+    for (int j = 0; j < size; ++j) {
+      vector_map::Point p;
+      p.bx = position(gen);
+      p.ly = position(gen);
+      coarse_vmap.points.push_back(p);
+    }
+
+    double search_radius = (i % 3 == 0) ? 10.0 : 60.0;
+    for (int lno : { LNO_ALL, 1, 2 }) {
+      VectorMap fine_vmap = create_fine_vmap(lane_vmap, lno, coarse_vmap, search_radius, 10000);
+      expectEqual(linear::create_fine_vmap(lane_vmap, lno, coarse_vmap, search_radius, 10000), fine_vmap);
+      if (!fine_vmap.points.empty())
+        ++found;
+    }
+  }
+  // routes are found for part of the coarse points
+  ASSERT_GT(found, 0);
+}
+
+TEST_F(LanePlannerVmapTestSuite, modifiedLaneVmap)
+{
+  std::mt19937 gen(2);
+  VectorMap lane_vmap = create_lane_vmap(createGridMap(3, 3, 3, 50.0, &gen), LNO_ALL);
+
+  // same sizes, different contents: the index is reset by the modifying code
+  std::reverse(lane_vmap.points.begin(), lane_vmap.points.end());
+  for (vector_map::Point& p : lane_vmap.points)
+    p.bx += 1.0;
+  std::reverse(lane_vmap.lanes.begin(), lane_vmap.lanes.end());
+  lane_vmap.index.reset();
+
+  expectEqual(linear::create_branching_points(lane_vmap), create_branching_points(lane_vmap));
+  expectEqual(linear::create_merging_points(lane_vmap), create_merging_points(lane_vmap));
+  expectEqual(linear::create_lane_vmap(lane_vmap, 1), create_lane_vmap(lane_vmap, 1));
+
+  VectorMap coarse_vmap;
+  for (const vector_map::Point& p : lane_vmap.points) {
+    if (coarse_vmap.points.size() == 2)
+      break;
+    coarse_vmap.points.push_back(p);
+  }
+  expectEqual(linear::create_fine_vmap(lane_vmap, LNO_ALL, coarse_vmap, 60.0, 10000),
+              create_fine_vmap(lane_vmap, LNO_ALL, coarse_vmap, 60.0, 10000));
+}
+
+} // namespace vmap
+
+} // namespace lane_planner
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "TestNode");
+  return RUN_ALL_TESTS();
+}
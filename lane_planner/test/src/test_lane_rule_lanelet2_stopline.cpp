@@ -0,0 +1,173 @@
+/*
+ * Copyright 2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ros/ros.h>
+#include <gtest/gtest.h>
+
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/geometry/LineString.h>
+#include <lanelet2_core/primitives/BasicRegulatoryElements.h>
+#include <lanelet2_core/utility/Utilities.h>
+#include <lanelet2_extension/utility/query.h>
+
+#include <random>
+#include <vector>
+
+#include "lane_rule_lanelet2_stopline.h"
+
+class StopLineRTreeTestSuite : public ::testing::Test
+{
+public:
+  StopLineRTreeTestSuite() {}
+  ~StopLineRTreeTestSuite() {}
+
+  lanelet::Point3d point(const double x, const double y)
+  {
+    return lanelet::Point3d(lanelet::utils::getId(), x, y, 0.0);
+  }
+
+  lanelet::LineString3d lineString(const double x0, const double y0, const double x1, const double y1)
+  {
+    return lanelet::LineString3d(lanelet::utils::getId(), { point(x0, y0), point(x1, y1) });
+  }
+
+  lanelet::TrafficLight::Ptr trafficLight(const lanelet::LineString3d& stop_line)
+  {
+    lanelet::LineStringsOrPolygons3d lights;
+    lights.push_back(lanelet::LineStringOrPolygon3d(lineString(0.0, 10.0, 1.0, 10.0)));
+    return lanelet::TrafficLight::make(lanelet::utils::getId(), lanelet::AttributeMap(), lights, stop_line);
+  }
+
+  // two lanes of two lanelets along x, with traffic light stoplines across them
+  lanelet::LaneletMapPtr createMap()
+  {
+    lanelet::Lanelet ll_a(lanelet::utils::getId(), lineString(0.0, 2.0, 10.0, 2.0), lineString(0.0, -2.0, 10.0, -2.0));
+    lanelet::Lanelet ll_b(lanelet::utils::getId(), lineString(10.0, 2.0, 20.0, 2.0),
+                          lineString(10.0, -2.0, 20.0, -2.0));
+    lanelet::Lanelet ll_c(lanelet::utils::getId(), lineString(0.0, 6.0, 10.0, 6.0), lineString(0.0, 2.0, 10.0, 2.0));
+    lanelet::Lanelet ll_d(lanelet::utils::getId(), lineString(10.0, 6.0, 20.0, 6.0), lineString(10.0, 2.0, 20.0, 2.0));
+
+    // one stopline shared by both lanes
+    lanelet::TrafficLight::Ptr shared = trafficLight(lineString(8.0, -2.0, 8.0, 6.0));
+    ll_a.addRegulatoryElement(shared);
+    ll_c.addRegulatoryElement(shared);
+
+    // diagonal stopline and polyline stopline
+    ll_b.addRegulatoryElement(trafficLight(lineString(14.0, -2.0, 16.0, 2.0)));
+    lanelet::LineString3d polyline(lanelet::utils::getId(),
+                                   { point(15.0, 2.0), point(15.5, 4.0), point(15.0, 6.0) });
+    ll_d.addRegulatoryElement(trafficLight(polyline));
+
+    return lanelet::utils::createMap(lanelet::Lanelets{ ll_a, ll_b, ll_c, ll_d });
+  }
+
+  // stopline test of check_waypoints_for_stoplines before the rtree, creating lanelet primitives for each waypoint
+  size_t countIntersectionsPerWaypoint(const lanelet::ConstLanelet& current_lanelet, const Eigen::Vector3d& p0,
+                                       const Eigen::Vector3d& p1)
+  {
+    lanelet::Point3d wp_p0(lanelet::utils::getId(), p0.x(), p0.y(), p0.z());
+    lanelet::Point3d wp_p1(lanelet::utils::getId(), p1.x(), p1.y(), p1.z());
+
+    std::vector<lanelet::ConstLineString3d> current_lanelet_stoplines =
+        lanelet::utils::query::getTrafficLightStopLines(current_lanelet);
+
+    lanelet::ConstLineString3d wp_ls(lanelet::utils::getId(), { wp_p0, wp_p1 });
+    auto wp_ls2d = lanelet::utils::to2D(wp_ls);
+
+    size_t count = 0;
+    for (auto sl_i = current_lanelet_stoplines.begin(); sl_i < current_lanelet_stoplines.end(); sl_i++)
+    {
+      auto sl_ls2d = lanelet::utils::to2D(*sl_i);
+      if (lanelet::geometry::intersects(lanelet::utils::toHybrid(wp_ls2d), lanelet::utils::toHybrid(sl_ls2d)))
+        count++;
+    }
+    return count;
+  }
+
+  void expectSameCount(const lanelet::LaneletMapPtr& map, const lane_planner::StopLineRTree& rtree,
+                       const Eigen::Vector3d& p0, const Eigen::Vector3d& p1)
+  {
+    for (const lanelet::ConstLanelet& ll : map->laneletLayer)
+    {
+      ASSERT_EQ(countIntersectionsPerWaypoint(ll, p0, p1), rtree.countIntersections(ll.id(), p0, p1))
+          << "lanelet " << ll.id() << ", segment (" << p0.x() << ", " << p0.y() << ") - (" << p1.x() << ", "
+          << p1.y() << ")";
+    }
+  }
+};
+
+TEST_F(StopLineRTreeTestSuite, TestBuild)
+{
+  lanelet::LaneletMapPtr map = createMap();
+  lane_planner::StopLineRTree rtree;
+
+  rtree.build(map);
+  // the shared stopline has an entry for each lanelet
+  ASSERT_EQ(4U, rtree.size());
+
+  // rebuilt for a new map
+  rtree.build(std::make_shared<lanelet::LaneletMap>());
+  ASSERT_EQ(0U, rtree.size());
+  ASSERT_EQ(0U, rtree.countIntersections(lanelet::InvalId, Eigen::Vector3d(7.0, 0.0, 0.0),
+                                         Eigen::Vector3d(9.0, 0.0, 0.0)));
+}
+
+TEST_F(StopLineRTreeTestSuite, TestCountIntersections)
+{
+  lanelet::LaneletMapPtr map = createMap();
+  lane_planner::StopLineRTree rtree;
+  rtree.build(map);
+
+  // crossing and missing
+  expectSameCount(map, rtree, Eigen::Vector3d(7.0, 0.0, 0.0), Eigen::Vector3d(9.0, 0.0, 0.0));
+  expectSameCount(map, rtree, Eigen::Vector3d(7.0, 4.0, 1.0), Eigen::Vector3d(9.0, 4.0, 1.0));
+  expectSameCount(map, rtree, Eigen::Vector3d(14.0, 0.0, 0.0), Eigen::Vector3d(16.0, 0.0, 0.0));
+  expectSameCount(map, rtree, Eigen::Vector3d(14.0, 4.0, 0.0), Eigen::Vector3d(16.0, 4.0, 0.0));
+  expectSameCount(map, rtree, Eigen::Vector3d(7.0, 1.0, 0.0), Eigen::Vector3d(7.9, 1.0, 0.0));
+  expectSameCount(map, rtree, Eigen::Vector3d(1.0, 0.0, 0.0), Eigen::Vector3d(19.0, 0.0, 0.0));
+
+  // segments ending and starting exactly on a stopline
+  expectSameCount(map, rtree, Eigen::Vector3d(7.0, 0.0, 0.0), Eigen::Vector3d(8.0, 0.0, 0.0));
+  expectSameCount(map, rtree, Eigen::Vector3d(8.0, 0.0, 0.0), Eigen::Vector3d(9.0, 0.0, 0.0));
+  expectSameCount(map, rtree, Eigen::Vector3d(14.0, 0.0, 0.0), Eigen::Vector3d(15.0, 0.0, 0.0));
+  expectSameCount(map, rtree, Eigen::Vector3d(14.0, 4.0, 0.0), Eigen::Vector3d(15.5, 4.0, 0.0));
+
+  // segments touching an end of a stopline, and lying on it
+  expectSameCount(map, rtree, Eigen::Vector3d(7.0, -3.0, 0.0), Eigen::Vector3d(8.0, -2.0, 0.0));
+  expectSameCount(map, rtree, Eigen::Vector3d(8.0, -1.0, 0.0), Eigen::Vector3d(8.0, 1.0, 0.0));
+
+  // degenerate segment on a stopline
+  expectSameCount(map, rtree, Eigen::Vector3d(8.0, 0.0, 0.0), Eigen::Vector3d(8.0, 0.0, 0.0));
+
+  // random segments of a waypoint step around the stoplines
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> x(-1.0, 21.0);
+  std::uniform_real_distribution<double> y(-3.0, 7.0);
+  std::uniform_real_distribution<double> step(-2.0, 2.0);
+  for (int i = 0; i < 1000; i++)
+  {
+    const Eigen::Vector3d p0(x(gen), y(gen), 0.0);
+    const Eigen::Vector3d p1(p0.x() + step(gen), p0.y() + step(gen), 0.0);
+    expectSameCount(map, rtree, p0, p1);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "TestNode");
+  return RUN_ALL_TESTS();
+}
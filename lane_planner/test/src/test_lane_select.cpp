@@ -75,6 +75,50 @@ TEST_F(LaneSelectTestSuite, publishVehicleLocation) {
   }
 }
 
+TEST_F(LaneSelectTestSuite, getClosestWaypointNumber) {
+  autoware_msgs::Lane lane;
+  for (int idx = 0; idx < 1000; idx++) {
+    autoware_msgs::Waypoint wp;
+    wp.pose.pose.position.x = (double)idx;
+    wp.pose.pose.orientation = tf::createQuaternionMsgFromYaw(0.0);
+    wp.twist.twist.linear.x = 5.0;
+    lane.waypoints.push_back(wp);
+  }
+  geometry_msgs::Pose pose;
+  pose.orientation = tf::createQuaternionMsgFromYaw(0.0);
+  geometry_msgs::Twist twist;
+  twist.linear.x = 5.0;
+  const double threshold = 3.0;
+  const int minimum_dt = 10;
+
+  // search over the whole lane
+  pose.position.x = 10.3;
+  ASSERT_EQ(11, getClosestWaypointNumber(lane, pose, twist, -1, threshold, minimum_dt));
+
+  // search around the previous number, both forward and backward
+  pose.position.x = 12.6;
+  ASSERT_EQ(13, getClosestWaypointNumber(lane, pose, twist, 11, threshold, minimum_dt));
+  pose.position.x = 10.5;
+  ASSERT_EQ(11, getClosestWaypointNumber(lane, pose, twist, 13, threshold, minimum_dt));
+
+  // far away from the previous number
+  pose.position.x = 500.0;
+  ASSERT_EQ(-1, getClosestWaypointNumber(lane, pose, twist, 11, threshold, minimum_dt));
+
+  // facing the opposite direction
+  pose.position.x = 10.3;
+  pose.orientation = tf::createQuaternionMsgFromYaw(M_PI);
+  ASSERT_EQ(-1, getClosestWaypointNumber(lane, pose, twist, -1, threshold, minimum_dt));
+
+  // zero quaternion of a waypoint or of current pose
+  pose.orientation = tf::createQuaternionMsgFromYaw(0.0);
+  lane.waypoints.at(11).pose.pose.orientation = geometry_msgs::Quaternion();
+  lane.waypoints.at(11).pose.pose.orientation.w = 0.0;
+  ASSERT_EQ(12, getClosestWaypointNumber(lane, pose, twist, -1, threshold, minimum_dt));
+  pose.orientation = lane.waypoints.at(11).pose.pose.orientation;
+  ASSERT_EQ(-1, getClosestWaypointNumber(lane, pose, twist, -1, threshold, minimum_dt));
+}
+
 } // namespace lane_planner
 
 int main(int argc, char **argv) {
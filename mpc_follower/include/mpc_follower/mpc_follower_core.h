@@ -55,6 +55,7 @@
 #include "mpc_follower/qp_solver/qp_solver_unconstr.h"
 #include "mpc_follower/qp_solver/qp_solver_unconstr_fast.h"
 #include "mpc_follower/qp_solver/qp_solver_qpoases.h"
+#include "mpc_follower/qp_solver/qp_solver_riccati.h"
 
 /** 
  * @class MPC-based waypoints follower class
@@ -109,6 +110,7 @@ private:
   int path_smoothing_times_;       //< @brief number of times of applying path smoothing filter
   int curvature_smoothing_num_;    //< @brief point-to-point index distance used in curvature calculation
   double traj_resample_dist_;      //< @brief path resampling interval [m]
+  double nearest_search_dist_;     //< @brief distance searched around previous nearest point on path [m]
 
   struct MPCParam
   {
@@ -127,6 +129,27 @@ private:
   };
   MPCParam mpc_param_; // for mpc design parameter
 
+  struct MPCMatrix
+  {
+    Eigen::MatrixXd Adex;   //< @brief discrete state matrix of each step, (DIM_X * N) x DIM_X
+    Eigen::MatrixXd Bdex;   //< @brief discrete input matrix of each step, (DIM_X * N) x DIM_U
+    Eigen::MatrixXd Wdex;   //< @brief discrete disturbance of each step, (DIM_X * N) x 1
+    Eigen::MatrixXd Cdex;   //< @brief discrete output matrix of each step, (DIM_Y * N) x DIM_X
+    Eigen::MatrixXd Qdex;   //< @brief state weight of each step, (DIM_Y * N) x DIM_Y
+    Eigen::MatrixXd Rdex;   //< @brief diagonal blocks of input weight including lateral jerk, (DIM_U * N) x DIM_U
+    Eigen::MatrixXd Rlex;   //< @brief blocks coupling u(i) with u(i-1) by lateral jerk, (DIM_U * N) x DIM_U
+    Eigen::MatrixXd Urefex; //< @brief reference input, (DIM_U * N) x 1
+
+    /* condensed matrix, allocated only for the solvers which are not stage solver */
+    Eigen::MatrixXd Aex;    //< @brief state transition from initial state, (DIM_X * N) x DIM_X
+    Eigen::MatrixXd Bex;    //< @brief lower block triangular input matrix, (DIM_X * N) x (DIM_U * N)
+    Eigen::MatrixXd Wex;    //< @brief disturbance term, (DIM_X * N) x 1
+    Eigen::MatrixXd Cex;    //< @brief block diagonal output matrix, (DIM_Y * N) x (DIM_X * N)
+    Eigen::MatrixXd Qex;    //< @brief block diagonal state weight, (DIM_Y * N) x (DIM_Y * N)
+    Eigen::MatrixXd Rex;    //< @brief input weight including lateral jerk, (DIM_U * N) x (DIM_U * N)
+  };
+  MPCMatrix mpc_matrix_; //< @brief buffers of mpc matrix, allocated once for the horizon and model dimension
+
   struct VehicleStatus
   {
     std_msgs::Header header;    //< @brief header
@@ -145,6 +168,8 @@ private:
   bool my_velocity_ok_; //< @brief flag for validity of current velocity
   bool my_steering_ok_; //< @brief flag for validity of steering angle
 
+  int prev_nearest_index_; //< @brief nearest index on ref_traj_ in previous period, -1 when it is not available
+
   /**
    * @brief compute and publish control command for path follow with a constant control period
    */
@@ -199,6 +224,25 @@ private:
    */
   bool calculateMPC(double &vel_cmd, double &acc_cmd, double &steer_cmd, double &steer_vel_cmd);
 
+  /**
+   * @brief allocate mpc_matrix_ with zero for the prediction horizon and the vehicle model dimension
+   * the condensed matrix is left empty for the stage solver
+   * @param [in] N prediction horizon step
+   * @param [in] DIM_X dimension of state
+   * @param [in] DIM_U dimension of input
+   * @param [in] DIM_Y dimension of output
+   */
+  void initializeMPCMatrix(const int N, const int DIM_X, const int DIM_U, const int DIM_Y);
+
+  /**
+   * @brief calculate hessian and gradient of condensed QP from mpc_matrix_ with block operations
+   * H = Bex' * Cex' * Qex * Cex * Bex + Rex, f = (Cex * (Aex * x0 + Wex))' * Qex * Cex * Bex - Urefex' * Rex
+   * @param [in] x0 initial state
+   * @param [out] H hessian matrix
+   * @param [out] f gradient (row vector)
+   */
+  void calcCondensedQP(const Eigen::VectorXd &x0, Eigen::MatrixXd &H, Eigen::MatrixXd &f);
+
   /* debug */
   bool show_debug_info_;      //!< @brief flag to display debug info
 
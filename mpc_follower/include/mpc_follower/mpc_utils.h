@@ -51,6 +51,17 @@ void convertEulerAngleToMonotonic(std::vector<double> &a);
 template <typename T1, typename T2>
 bool interp1d(const T1 &index, const T2 &values, const double &ref, double &ret);
 
+/**
+ * @brief interpolate value vector at sorted reference indices in a single pass
+ * @param [in] index index vector related to object value (Eigen::Vector or std::vector)
+ * @param [in] values object value vector (Eigen::Vector or std::vector)
+ * @param [in] ref reference indices in increasing order
+ * @param [out] ret interpolated values, same as interp1d() for each reference index
+ * @return bool to check whether it was interpolated properly
+ */
+template <typename T1, typename T2>
+bool interp1d(const T1 &index, const T2 &values, const std::vector<double> &ref, std::vector<double> &ret);
+
 /**
  * @brief interpolate MPCTrajectory at index vector
  * @param [in] index index vector related to MPCTrajectory value 
@@ -148,4 +159,33 @@ bool calcNearestPose(const MPCTrajectory &traj, const geometry_msgs::Pose &self_
 bool calcNearestPoseInterp(const MPCTrajectory &traj, const geometry_msgs::Pose &self_pose, geometry_msgs::Pose &nearest_pose,
                            unsigned int &nearest_index, double &min_dist_error, double &nearest_yaw_error, double &nearest_time);
 
+/**
+ * @brief calculate nearest pose on MPCTrajectory with linear interpolation, searching around previous nearest index
+ * @param [in] traj reference trajectory
+ * @param [in] self_pose object pose 
+ * @param [in] prev_nearest_index nearest index at previous call. whole trajectory is searched when negative
+ * @param [in] search_window number of points searched before and after prev_nearest_index
+ * @param [out] nearest_pose nearest pose on path
+ * @param [out] nearest_index path index of nearest pose 
+ * @param [out] min_dist_error distance error from nearest pose to self pose
+ * @param [out] nearest_yaw_error yaw angle error from nearest pose to self pose
+ * @param [out] nearest_time time of nearest pose on trajectory
+ * @return false when nearest pose couldn't find for some reasons
+ */
+bool calcNearestPoseInterp(const MPCTrajectory &traj, const geometry_msgs::Pose &self_pose, const int prev_nearest_index,
+                           const unsigned int search_window, geometry_msgs::Pose &nearest_pose, unsigned int &nearest_index,
+                           double &min_dist_error, double &nearest_yaw_error, double &nearest_time);
+
+/**
+ * @brief calculate nearest point index in [begin, end) ignoring points with large yaw error
+ * @param [in] traj reference trajectory
+ * @param [in] self_pose object pose 
+ * @param [in] begin first index to be searched
+ * @param [in] end last index to be searched + 1
+ * @param [out] min_dist_squared squared distance to nearest point
+ * @return nearest index, -1 when no point is found
+ */
+int calcNearestIndex(const MPCTrajectory &traj, const geometry_msgs::Pose &self_pose, const unsigned int begin,
+                     const unsigned int end, double &min_dist_squared);
+
 }; // namespace MPCUtils
\ No newline at end of file
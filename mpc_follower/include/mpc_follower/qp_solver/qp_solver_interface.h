@@ -45,4 +45,34 @@ public:
   virtual bool solve(const Eigen::MatrixXd &Hmat, const Eigen::MatrixXd &fvec, const Eigen::MatrixXd &A,
                      const Eigen::VectorXd &lb, const Eigen::VectorXd &ub, const Eigen::MatrixXd &lbA,
                      const Eigen::MatrixXd &ubA, Eigen::VectorXd &U) = 0;
+
+  /**
+   * @brief check if the solver takes the stage-wise problem with solveStage() instead of the condensed one
+   */
+  virtual bool isStageSolver() const { return false; }
+
+  /**
+   * @brief solve QP problem given stage by stage for i = 0, ..., N-1 without constraint
+   * dynamics : x(i+1) = Ad(i) * x(i) + Bd(i) * u(i) + Wd(i)
+   * cost : sum of (Cd(i) * x(i+1))' * Qd(i) * (Cd(i) * x(i+1)) + (U - Urefex)' * Rex * (U - Urefex),
+   *        Rex is block tridiagonal with Rex(i, i) = Rd(i) and Rex(i, i-1) = Rex(i-1, i)' = Rl(i)
+   * @param [in] x0 initial state
+   * @param [in] Adex Ad(i) stacked vertically, (DIM_X * N) x DIM_X
+   * @param [in] Bdex Bd(i) stacked vertically, (DIM_X * N) x DIM_U
+   * @param [in] Wdex Wd(i) stacked vertically, (DIM_X * N) x 1
+   * @param [in] Cdex Cd(i) stacked vertically, (DIM_Y * N) x DIM_X
+   * @param [in] Qdex Qd(i) stacked vertically, (DIM_Y * N) x DIM_Y
+   * @param [in] Rdex Rd(i) stacked vertically, (DIM_U * N) x DIM_U
+   * @param [in] Rlex Rl(i) stacked vertically, Rl(0) is not used, (DIM_U * N) x DIM_U
+   * @param [in] Urefex reference input, (DIM_U * N) x 1
+   * @param [out] U optimal variable vector
+   * @return bool to check the problem is solved
+   */
+  virtual bool solveStage(const Eigen::VectorXd &x0, const Eigen::MatrixXd &Adex, const Eigen::MatrixXd &Bdex,
+                          const Eigen::MatrixXd &Wdex, const Eigen::MatrixXd &Cdex, const Eigen::MatrixXd &Qdex,
+                          const Eigen::MatrixXd &Rdex, const Eigen::MatrixXd &Rlex, const Eigen::MatrixXd &Urefex,
+                          Eigen::VectorXd &U)
+  {
+    return false;
+  }
 };
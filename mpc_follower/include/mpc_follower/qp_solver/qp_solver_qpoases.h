@@ -29,6 +29,7 @@
 #include <eigen3/Eigen/LU>
 #include <qpoases_vendor/qpOASES.hpp>
 #include <cmath>
+#include <vector>
 
 #include "mpc_follower/qp_solver/qp_solver_interface.h"
 
@@ -38,6 +39,20 @@ private:
   bool is_solver_initialized_;  //!< @brief flag to check initialization
   const int max_iter_;          //!< @brief max iteration number
   qpOASES::SQProblem solver_;   //!< @brief solver for QP
+  int num_variables_;           //!< @brief problem size solver_ is set up for
+
+  /* row-major buffers given to solver_, kept across calls */
+  std::vector<double> h_matrix_;            //!< @brief hessian
+  std::vector<double> g_vector_;            //!< @brief gradient
+  std::vector<double> a_constraint_matrix_; //!< @brief constraint matrix (identity, constant for the size)
+  std::vector<double> lower_bound_;         //!< @brief lower bound for both variables and constraints
+  std::vector<double> upper_bound_;         //!< @brief upper bound for both variables and constraints
+
+  /**
+   * @brief allocate buffers and reset solver_ for the problem size
+   * @param [in] num_variables number of optimization variables
+   */
+  void resize(const int num_variables);
 
 public:
   /**
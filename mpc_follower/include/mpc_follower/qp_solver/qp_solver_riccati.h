@@ -0,0 +1,88 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file qp_solver_riccati.h
+ * @brief qp solver with backward riccati recursion
+ */
+
+#pragma once
+
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/Dense>
+#include <eigen3/Eigen/LU>
+#include <cmath>
+#include "mpc_follower/qp_solver/qp_solver_interface.h"
+
+/**
+ * @brief unconstrained solver scaling linearly with the prediction horizon
+ * The lateral jerk term couples u(i) and u(i-1), then the recursion runs on the state z(i) = [x(i); u(i-1)].
+ */
+class QPSolverRiccati : public QPSolverInterface
+{
+private:
+  Eigen::MatrixXd K_; //!< @brief feedback gain of each step, (DIM_U * N) x (DIM_X + DIM_U)
+  Eigen::VectorXd k_; //!< @brief feedforward input of each step, (DIM_U * N)
+  Eigen::LLT<Eigen::MatrixXd> llt_; //!< @brief cholesky decomposition of Hmat for condensed problem
+
+public:
+  /**
+   * @brief constructor
+   */
+  QPSolverRiccati();
+
+  /**
+   * @brief destructor
+   */
+  ~QPSolverRiccati() = default;
+
+  /**
+   * @brief solve condensed QP problem : minimize J = U' * Hmat * U + fvec' * U without constraint, with LLT
+   * @param [in] Hmat parameter matrix in object function
+   * @param [in] fvec parameter matrix in object function
+   * @param [in] A parameter matrix for constraint lbA < A*U < ubA (not used here)
+   * @param [in] lb parameter matrix for constraint lb < U < ub (not used here)
+   * @param [in] up parameter matrix for constraint lb < U < ub (not used here)
+   * @param [in] lbA parameter matrix for constraint lbA < A*U < ubA (not used here)
+   * @param [in] ubA parameter matrix for constraint lbA < A*U < ubA (not used here)
+   * @param [out] U optimal variable vector
+   * @return bool to check the problem is solved
+   */
+  bool solve(const Eigen::MatrixXd &Hmat, const Eigen::MatrixXd &fvec, const Eigen::MatrixXd &A,
+             const Eigen::VectorXd &lb, const Eigen::VectorXd &ub, const Eigen::MatrixXd &lbA,
+             const Eigen::MatrixXd &ubA, Eigen::VectorXd &U) override;
+
+  bool isStageSolver() const override { return true; }
+
+  /**
+   * @brief solve QP problem given stage by stage with backward riccati recursion and forward simulation
+   * @param [in] x0 initial state
+   * @param [in] Adex Ad(i) stacked vertically
+   * @param [in] Bdex Bd(i) stacked vertically
+   * @param [in] Wdex Wd(i) stacked vertically
+   * @param [in] Cdex Cd(i) stacked vertically
+   * @param [in] Qdex Qd(i) stacked vertically
+   * @param [in] Rdex diagonal blocks of input weight stacked vertically
+   * @param [in] Rlex blocks coupling u(i) with u(i-1) stacked vertically
+   * @param [in] Urefex reference input
+   * @param [out] U optimal variable vector
+   * @return bool to check the problem is solved
+   */
+  bool solveStage(const Eigen::VectorXd &x0, const Eigen::MatrixXd &Adex, const Eigen::MatrixXd &Bdex,
+                  const Eigen::MatrixXd &Wdex, const Eigen::MatrixXd &Cdex, const Eigen::MatrixXd &Qdex,
+                  const Eigen::MatrixXd &Rdex, const Eigen::MatrixXd &Rlex, const Eigen::MatrixXd &Urefex,
+                  Eigen::VectorXd &U) override;
+};
@@ -31,6 +31,9 @@
 
 class QPSolverEigenLeastSquareLLT : public QPSolverInterface
 {
+private:
+  Eigen::LLT<Eigen::MatrixXd> llt_; //!< @brief cholesky decomposition of Hmat, storage is kept over calls
+
 public:
   /**
    * @brief constructor
@@ -52,7 +55,7 @@ public:
    * @param [in] lbA parameter matrix for constraint lbA < A*U < ubA (not used here)
    * @param [in] ubA parameter matrix for constraint lbA < A*U < ubA (not used here)
    * @param [out] U optimal variable vector
-   * @return bool to check the problem is solved
+   * @return bool to check the problem is solved, false when Hmat is not positive definite
    */
   bool solve(const Eigen::MatrixXd &Hmat, const Eigen::MatrixXd &fvec, const Eigen::MatrixXd &A,
              const Eigen::VectorXd &lb, const Eigen::VectorXd &ub, const Eigen::MatrixXd &lbA,
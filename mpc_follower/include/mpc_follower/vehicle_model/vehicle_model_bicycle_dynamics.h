@@ -59,7 +59,7 @@
  * @class vehicle model class of bicycle dynamics
  * @brief calculate model-related values
  */
-class DynamicsBicycleModel : public VehicleModelInterface
+class DynamicsBicycleModel : public VehicleModelFixedSize<4, 1, 2>
 {
 public:
   /**
@@ -88,8 +88,7 @@ public:
    * @param [in] Wd coefficient matrix
    * @param [in] dt Discretization time
    */
-  void calculateDiscreteMatrix(Eigen::MatrixXd &Ad, Eigen::MatrixXd &Bd,
-                               Eigen::MatrixXd &Wd, Eigen::MatrixXd &Cd, const double &dt) override;
+  void calculateDiscreteMatrixFixed(MatrixA &Ad, MatrixB &Bd, MatrixC &Cd, MatrixW &Wd, const double &dt) override;
 
   /**
    * @brief calculate reference input
@@ -58,7 +58,7 @@
  * @class vehicle model class of bicycle kinematics
  * @brief calculate model-related values
  */
-class KinematicsBicycleModel : public VehicleModelInterface
+class KinematicsBicycleModel : public VehicleModelFixedSize<3, 1, 2>
 {
 public:
   /**
@@ -82,8 +82,7 @@ public:
    * @param [out] Wd coefficient matrix
    * @param [in] dt Discretization time
    */
-  void calculateDiscreteMatrix(Eigen::MatrixXd &Ad, Eigen::MatrixXd &Bd,
-                               Eigen::MatrixXd &Cd, Eigen::MatrixXd &Wd, const double &dt) override;
+  void calculateDiscreteMatrixFixed(MatrixA &Ad, MatrixB &Bd, MatrixC &Cd, MatrixW &Wd, const double &dt) override;
 
   /**
    * @brief calculate reference input
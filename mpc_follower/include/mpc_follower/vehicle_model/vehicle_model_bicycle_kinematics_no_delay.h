@@ -56,7 +56,7 @@
  * @class vehicle model class of bicycle kinematics without steering delay
  * @brief calculate model-related values
  */
-class KinematicsBicycleModelNoDelay : public VehicleModelInterface
+class KinematicsBicycleModelNoDelay : public VehicleModelFixedSize<2, 1, 2>
 {
 public:
   /**
@@ -79,8 +79,7 @@ public:
    * @param [out] Wd coefficient matrix
    * @param [in] dt Discretization time
    */
-  void calculateDiscreteMatrix(Eigen::MatrixXd &Ad, Eigen::MatrixXd &Bd,
-                               Eigen::MatrixXd &Cd, Eigen::MatrixXd &Wd, const double &dt) override;
+  void calculateDiscreteMatrixFixed(MatrixA &Ad, MatrixB &Bd, MatrixC &Cd, MatrixW &Wd, const double &dt) override;
 
   /**
    * @brief calculate reference input
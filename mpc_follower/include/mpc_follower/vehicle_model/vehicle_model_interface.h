@@ -93,3 +93,54 @@ public:
    */
   virtual void calculateReferenceInput(Eigen::MatrixXd &Uref) = 0;
 };
+
+/**
+ * @class vehicle model class with the dimensions fixed at compile time
+ * @brief discretize the model with fixed-size matrices, which are unrolled without memory allocation
+ */
+template <int DIM_X, int DIM_U, int DIM_Y>
+class VehicleModelFixedSize : public VehicleModelInterface
+{
+public:
+  using MatrixA = Eigen::Matrix<double, DIM_X, DIM_X>; //!< @brief type of state matrix
+  using MatrixB = Eigen::Matrix<double, DIM_X, DIM_U>; //!< @brief type of input matrix
+  using MatrixC = Eigen::Matrix<double, DIM_Y, DIM_X>; //!< @brief type of output matrix
+  using MatrixW = Eigen::Matrix<double, DIM_X, 1>;     //!< @brief type of disturbance vector
+
+  /**
+   * @brief constructor
+   */
+  VehicleModelFixedSize() : VehicleModelInterface(DIM_X, DIM_U, DIM_Y){};
+
+  /**
+   * @brief calculate discrete model matrix of x_k+1 = Ad * xk + Bd * uk + Wd, yk = Cd * xk
+   * @param [out] Ad coefficient matrix, not reallocated if already sized
+   * @param [out] Bd coefficient matrix, not reallocated if already sized
+   * @param [out] Cd coefficient matrix, not reallocated if already sized
+   * @param [out] Wd coefficient matrix, not reallocated if already sized
+   * @param [in] dt Discretization time
+   */
+  void calculateDiscreteMatrix(Eigen::MatrixXd &Ad, Eigen::MatrixXd &Bd, Eigen::MatrixXd &Cd, Eigen::MatrixXd &Wd,
+                               const double &dt) override
+  {
+    MatrixA Ad_fixed;
+    MatrixB Bd_fixed;
+    MatrixC Cd_fixed;
+    MatrixW Wd_fixed;
+    calculateDiscreteMatrixFixed(Ad_fixed, Bd_fixed, Cd_fixed, Wd_fixed, dt);
+    Ad = Ad_fixed;
+    Bd = Bd_fixed;
+    Cd = Cd_fixed;
+    Wd = Wd_fixed;
+  }
+
+  /**
+   * @brief calculate discrete model matrix of x_k+1 = Ad * xk + Bd * uk + Wd, yk = Cd * xk with fixed-size matrices
+   * @param [out] Ad coefficient matrix
+   * @param [out] Bd coefficient matrix
+   * @param [out] Cd coefficient matrix
+   * @param [out] Wd coefficient matrix
+   * @param [in] dt Discretization time
+   */
+  virtual void calculateDiscreteMatrixFixed(MatrixA &Ad, MatrixB &Bd, MatrixC &Cd, MatrixW &Wd, const double &dt) = 0;
+};
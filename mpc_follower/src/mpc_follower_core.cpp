@@ -19,7 +19,7 @@
 #define DEBUG_INFO(...) { if (show_debug_info_) { ROS_INFO(__VA_ARGS__); }}
 
 MPCFollower::MPCFollower()
-    : nh_(""), pnh_("~"), my_position_ok_(false), my_velocity_ok_(false), my_steering_ok_(false)
+    : nh_(""), pnh_("~"), my_position_ok_(false), my_velocity_ok_(false), my_steering_ok_(false), prev_nearest_index_(-1)
 {
   pnh_.param("show_debug_info", show_debug_info_, bool(false));
   pnh_.param("ctrl_period", ctrl_period_, double(0.03));
@@ -29,6 +29,7 @@ MPCFollower::MPCFollower()
   pnh_.param("path_smoothing_times", path_smoothing_times_, int(1));
   pnh_.param("curvature_smoothing_num", curvature_smoothing_num_, int(35));
   pnh_.param("traj_resample_dist", traj_resample_dist_, double(0.1)); // [m]
+  pnh_.param("nearest_search_dist", nearest_search_dist_, double(5.0)); // [m]
   pnh_.param("admisible_position_error", admisible_position_error_, double(5.0));
   pnh_.param("admisible_yaw_error_deg", admisible_yaw_error_deg_, double(90.0));
   pnh_.param("output_interface", output_interface_, std::string("all"));
@@ -103,11 +104,22 @@ MPCFollower::MPCFollower()
     qpsolver_ptr_ = std::make_shared<QPSolverQpoasesHotstart>(max_iter);
     ROS_INFO("[MPC] set qp solver = qpoases_hotstart");
   }
+  else if (qp_solver_type_ == "riccati")
+  {
+    qpsolver_ptr_ = std::make_shared<QPSolverRiccati>();
+    ROS_INFO("[MPC] set qp solver = riccati");
+  }
   else
   {
     ROS_ERROR("[MPC] qp_solver_type is undefined");
   }
 
+  if (vehicle_model_ptr_ != nullptr)
+  {
+    initializeMPCMatrix(mpc_param_.prediction_horizon, vehicle_model_ptr_->getDimX(), vehicle_model_ptr_->getDimU(),
+                        vehicle_model_ptr_->getDimY());
+  }
+
   steer_cmd_prev_ = 0.0;
   lateral_error_prev_ = 0.0;
   yaw_error_prev_ = 0.0;
@@ -148,6 +160,84 @@ MPCFollower::MPCFollower()
   sub_estimate_twist_ = nh_.subscribe("estimate_twist", 1, &MPCFollower::callbackEstimateTwist, this);
 };
 
+void MPCFollower::initializeMPCMatrix(const int N, const int DIM_X, const int DIM_U, const int DIM_Y)
+{
+  mpc_matrix_.Adex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_X);
+  mpc_matrix_.Bdex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_U);
+  mpc_matrix_.Wdex = Eigen::MatrixXd::Zero(DIM_X * N, 1);
+  mpc_matrix_.Cdex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_X);
+  mpc_matrix_.Qdex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_Y);
+  mpc_matrix_.Rdex = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U);
+  mpc_matrix_.Rlex = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U);
+  mpc_matrix_.Urefex = Eigen::MatrixXd::Zero(DIM_U * N, 1);
+
+  if (qpsolver_ptr_ != nullptr && qpsolver_ptr_->isStageSolver())
+  {
+    mpc_matrix_.Aex.resize(0, 0);
+    mpc_matrix_.Bex.resize(0, 0);
+    mpc_matrix_.Wex.resize(0, 0);
+    mpc_matrix_.Cex.resize(0, 0);
+    mpc_matrix_.Qex.resize(0, 0);
+    mpc_matrix_.Rex.resize(0, 0);
+    return;
+  }
+  mpc_matrix_.Aex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_X);
+  mpc_matrix_.Bex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_U * N);
+  mpc_matrix_.Wex = Eigen::MatrixXd::Zero(DIM_X * N, 1);
+  mpc_matrix_.Cex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_X * N);
+  mpc_matrix_.Qex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_Y * N);
+  mpc_matrix_.Rex = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U * N);
+}
+
+void MPCFollower::calcCondensedQP(const Eigen::VectorXd &x0, Eigen::MatrixXd &H, Eigen::MatrixXd &f)
+{
+  const int N = mpc_param_.prediction_horizon;
+  const int DIM_X = vehicle_model_ptr_->getDimX();
+  const int DIM_U = vehicle_model_ptr_->getDimU();
+  const int DIM_Y = vehicle_model_ptr_->getDimY();
+  const MPCMatrix &m = mpc_matrix_;
+
+  /*
+   * Bex(i, j) = Ad_i * Ad_i-1 * ... * Ad_j+1 * Bd_j is block lower triangular, and Cex, Qex are block diagonal.
+   * With Mi = Ci' * Qi * Ci and ei = Aex_i * x0 + Wex_i, the sums over the horizon are accumulated backward as
+   *   Pi = Mi + Ad_i+1' * Pi+1 * Ad_i+1,  gi = Mi * ei + Ad_i+1' * gi+1
+   * then H(j, i) = Bex(i, j)' * Pi * Bd_i for j <= i, and f_i = gi' * Bd_i. (O(N^2) instead of O(N^3))
+   */
+  const Eigen::VectorXd e = m.Aex * x0 + m.Wex;
+  Eigen::MatrixXd P(DIM_X, DIM_X);
+  Eigen::MatrixXd M(DIM_X, DIM_X);
+  Eigen::MatrixXd PB(DIM_X, DIM_U);
+  Eigen::VectorXd g(DIM_X);
+  for (int i = N - 1; i >= 0; --i)
+  {
+    const int idx_x_i = i * DIM_X;
+    const int idx_u_i = i * DIM_U;
+    const int idx_y_i = i * DIM_Y;
+    const auto Ci = m.Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X);
+    const auto Qi = m.Qex.block(idx_y_i, idx_y_i, DIM_Y, DIM_Y);
+    const auto Bi = m.Bex.block(idx_x_i, idx_u_i, DIM_X, DIM_U);
+    M.noalias() = Ci.transpose() * (Qi * Ci);
+    if (i == N - 1)
+    {
+      P = M;
+      g.noalias() = M * e.segment(idx_x_i, DIM_X);
+    }
+    else
+    {
+      const auto A_next = m.Adex.block(idx_x_i + DIM_X, 0, DIM_X, DIM_X);
+      P = M + A_next.transpose() * P * A_next;
+      g = M * e.segment(idx_x_i, DIM_X) + A_next.transpose() * g;
+    }
+    PB.noalias() = P * Bi;
+    H.block(0, idx_u_i, idx_u_i + DIM_U, DIM_U).noalias() = m.Bex.block(idx_x_i, 0, DIM_X, idx_u_i + DIM_U).transpose() * PB;
+    f.block(0, idx_u_i, 1, DIM_U).noalias() = g.transpose() * Bi;
+  }
+
+  H.triangularView<Eigen::Upper>() += m.Rex;
+  H.triangularView<Eigen::Lower>() = H.transpose();
+  f -= m.Urefex.transpose() * m.Rex;
+}
+
 void MPCFollower::timerCallback(const ros::TimerEvent &te)
 {
 
@@ -210,11 +300,15 @@ bool MPCFollower::calculateMPC(double &vel_cmd, double &acc_cmd, double &steer_c
   unsigned int nearest_index = 0;
   double yaw_err, dist_err, nearest_traj_time;
   geometry_msgs::Pose nearest_pose;
-  if (!MPCUtils::calcNearestPoseInterp(ref_traj_, vehicle_status_.pose, nearest_pose, nearest_index, dist_err, yaw_err, nearest_traj_time))
+  const unsigned int search_window = std::ceil(nearest_search_dist_ / traj_resample_dist_);
+  if (!MPCUtils::calcNearestPoseInterp(ref_traj_, vehicle_status_.pose, prev_nearest_index_, search_window, nearest_pose,
+                                       nearest_index, dist_err, yaw_err, nearest_traj_time))
   {
+    prev_nearest_index_ = -1;
     ROS_WARN("[MPC] calculateMPC: error in calculating nearest pose. stop mpc.");
     return false;
   };
+  prev_nearest_index_ = nearest_index;
 
   /* check if lateral error is not too large */
   if (dist_err > admisible_position_error_ || std::fabs(yaw_err) > amathutils::deg2rad(admisible_yaw_error_deg_ ))
@@ -286,20 +380,24 @@ bool MPCFollower::calculateMPC(double &vel_cmd, double &acc_cmd, double &steer_c
 
   Eigen::MatrixXd x_curr = x0;
   double mpc_curr_time = mpc_start_time;
+  std::vector<double> delay_time_v, delay_k_v, delay_vx_v;
+  double delay_time = mpc_curr_time;
+  for (unsigned int i = 0; i < input_buffer_.size(); ++i)
+  {
+    delay_time_v.push_back(delay_time);
+    delay_time += ctrl_period_;
+  }
+  if (!MPCUtils::interp1d(ref_traj_.relative_time, ref_traj_.k, delay_time_v, delay_k_v) ||
+      !MPCUtils::interp1d(ref_traj_.relative_time, ref_traj_.vx, delay_time_v, delay_vx_v))
+  {
+    ROS_WARN("[MPC] calculateMPC: mpc resample error at delay compensation, stop mpc calculation. check code!");
+    return false;
+  }
   for (unsigned int i = 0; i < input_buffer_.size(); ++i)
   {
-    double k = 0.0;
-    double v = 0.0;
-    if (!MPCUtils::interp1d(ref_traj_.relative_time, ref_traj_.k, mpc_curr_time, k) ||
-        !MPCUtils::interp1d(ref_traj_.relative_time, ref_traj_.vx, mpc_curr_time, v))
-    {
-      ROS_WARN("[MPC] calculateMPC: mpc resample error at delay compensation, stop mpc calculation. check code!");
-      return false;
-    }
-
     /* get discrete state matrix A, B, C, W */
-    vehicle_model_ptr_->setVelocity(v);
-    vehicle_model_ptr_->setCurvature(k);
+    vehicle_model_ptr_->setVelocity(delay_vx_v[i]);
+    vehicle_model_ptr_->setCurvature(delay_k_v[i]);
     vehicle_model_ptr_->calculateDiscreteMatrix(Ad, Bd, Cd, Wd, ctrl_period_);
     Eigen::MatrixXd ud = Eigen::MatrixXd::Zero(DIM_U, 1);
     ud(0, 0) = input_buffer_.at(i); // for steering input delay
@@ -316,13 +414,33 @@ bool MPCFollower::calculateMPC(double &vel_cmd, double &acc_cmd, double &steer_c
    * Qex = diag([Q,Q,...]), Rex = diag([R,R,...])
    */
 
-  Eigen::MatrixXd Aex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_X);
-  Eigen::MatrixXd Bex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_U * N);
-  Eigen::MatrixXd Wex = Eigen::MatrixXd::Zero(DIM_X * N, 1);
-  Eigen::MatrixXd Cex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_X * N);
-  Eigen::MatrixXd Qex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_Y * N);
-  Eigen::MatrixXd Rex = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U * N);
-  Eigen::MatrixXd Urefex = Eigen::MatrixXd::Zero(DIM_U * N, 1);
+  const bool is_stage_solver = qpsolver_ptr_->isStageSolver();
+  if (mpc_matrix_.Adex.rows() != DIM_X * N || mpc_matrix_.Adex.cols() != DIM_X ||
+      mpc_matrix_.Urefex.rows() != DIM_U * N || mpc_matrix_.Cdex.rows() != DIM_Y * N ||
+      (!is_stage_solver && mpc_matrix_.Aex.rows() != DIM_X * N))
+  {
+    initializeMPCMatrix(N, DIM_X, DIM_U, DIM_Y);
+  }
+
+  /*
+   * Adex, Bdex, Wdex, Cdex, Qdex, Rdex, Rlex and Urefex are overwritten below, the first block of Rlex stays zero.
+   * For the condensed solvers, Aex, Wex, the lower block triangle of Bex, the diagonal blocks of Cex and Qex and
+   * the block tridiagonal of Rex are overwritten too, the other blocks stay zero.
+   */
+  Eigen::MatrixXd &Adex = mpc_matrix_.Adex;
+  Eigen::MatrixXd &Bdex = mpc_matrix_.Bdex;
+  Eigen::MatrixXd &Wdex = mpc_matrix_.Wdex;
+  Eigen::MatrixXd &Cdex = mpc_matrix_.Cdex;
+  Eigen::MatrixXd &Qdex = mpc_matrix_.Qdex;
+  Eigen::MatrixXd &Rdex = mpc_matrix_.Rdex;
+  Eigen::MatrixXd &Rlex = mpc_matrix_.Rlex;
+  Eigen::MatrixXd &Urefex = mpc_matrix_.Urefex;
+  Eigen::MatrixXd &Aex = mpc_matrix_.Aex;
+  Eigen::MatrixXd &Bex = mpc_matrix_.Bex;
+  Eigen::MatrixXd &Wex = mpc_matrix_.Wex;
+  Eigen::MatrixXd &Cex = mpc_matrix_.Cex;
+  Eigen::MatrixXd &Qex = mpc_matrix_.Qex;
+  Eigen::MatrixXd &Rex = mpc_matrix_.Rex;
 
   /* weight matrix depends on the vehicle model */
   Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(DIM_Y, DIM_Y);
@@ -373,26 +491,33 @@ bool MPCFollower::calculateMPC(double &vel_cmd, double &acc_cmd, double &steer_c
     int idx_x_i_prev = (i - 1) * DIM_X;
     int idx_u_i = i * DIM_U;
     int idx_y_i = i * DIM_Y;
-    if (i == 0)
-    {
-      Aex.block(0, 0, DIM_X, DIM_X) = Ad;
-      Bex.block(0, 0, DIM_X, DIM_U) = Bd;
-      Wex.block(0, 0, DIM_X, 1) = Wd;
-    }
-    else
+    if (!is_stage_solver)
     {
-      Aex.block(idx_x_i, 0, DIM_X, DIM_X) = Ad * Aex.block(idx_x_i_prev, 0, DIM_X, DIM_X);
-      for (int j = 0; j < i; ++j)
+      /* condensed matrix, not needed by the stage solver */
+      if (i == 0)
       {
-        int idx_u_j = j * DIM_U;
-        Bex.block(idx_x_i, idx_u_j, DIM_X, DIM_U) = Ad * Bex.block(idx_x_i_prev, idx_u_j, DIM_X, DIM_U);
+        Aex.block(0, 0, DIM_X, DIM_X) = Ad;
+        Bex.block(0, 0, DIM_X, DIM_U) = Bd;
+        Wex.block(0, 0, DIM_X, 1) = Wd;
       }
-      Wex.block(idx_x_i, 0, DIM_X, 1) = Ad * Wex.block(idx_x_i_prev, 0, DIM_X, 1) + Wd;
+      else
+      {
+        Aex.block(idx_x_i, 0, DIM_X, DIM_X).noalias() = Ad * Aex.block(idx_x_i_prev, 0, DIM_X, DIM_X);
+        /* Bex(i, j) = Ad * Bex(i - 1, j) for j < i, the whole block row is one product */
+        Bex.block(idx_x_i, 0, DIM_X, idx_u_i).noalias() = Ad * Bex.block(idx_x_i_prev, 0, DIM_X, idx_u_i);
+        Wex.block(idx_x_i, 0, DIM_X, 1).noalias() = Ad * Wex.block(idx_x_i_prev, 0, DIM_X, 1);
+        Wex.block(idx_x_i, 0, DIM_X, 1) += Wd;
+      }
+      Bex.block(idx_x_i, idx_u_i, DIM_X, DIM_U) = Bd;
+      Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X) = Cd;
+      Qex.block(idx_y_i, idx_y_i, DIM_Y, DIM_Y) = Q_adaptive;
     }
-    Bex.block(idx_x_i, idx_u_i, DIM_X, DIM_U) = Bd;
-    Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X) = Cd;
-    Qex.block(idx_y_i, idx_y_i, DIM_Y, DIM_Y) = Q_adaptive;
-    Rex.block(idx_u_i, idx_u_i, DIM_U, DIM_U) = R_adaptive;
+    Adex.block(idx_x_i, 0, DIM_X, DIM_X) = Ad;
+    Bdex.block(idx_x_i, 0, DIM_X, DIM_U) = Bd;
+    Wdex.block(idx_x_i, 0, DIM_X, 1) = Wd;
+    Cdex.block(idx_y_i, 0, DIM_Y, DIM_X) = Cd;
+    Qdex.block(idx_y_i, 0, DIM_Y, DIM_Y) = Q_adaptive;
+    Rdex.block(idx_u_i, 0, DIM_U, DIM_U) = R_adaptive;
 
     /* get reference input (feed-forward) */
     vehicle_model_ptr_->calculateReferenceInput(Uref);
@@ -411,14 +536,28 @@ bool MPCFollower::calculateMPC(double &vel_cmd, double &acc_cmd, double &steer_c
   {
     const double v = mpc_resampled_ref_traj.vx[i];
     const double lateral_jerk_weight = v * v * mpc_param_.weight_lat_jerk;
-    Rex(i, i) += lateral_jerk_weight;
-    Rex(i + 1, i) -= lateral_jerk_weight;
-    Rex(i, i + 1) -= lateral_jerk_weight;
-    Rex(i + 1, i + 1) += lateral_jerk_weight;
+    Rdex(i, 0) += lateral_jerk_weight;
+    Rlex(i + 1, 0) = -lateral_jerk_weight;
+    Rdex(i + 1, 0) += lateral_jerk_weight;
+  }
+
+  if (!is_stage_solver)
+  {
+    /* Rex is block tridiagonal, Rex(i, i - 1) = Rex(i - 1, i)' */
+    for (int i = 0; i < N; ++i)
+    {
+      const int idx_u_i = i * DIM_U;
+      Rex.block(idx_u_i, idx_u_i, DIM_U, DIM_U) = Rdex.block(idx_u_i, 0, DIM_U, DIM_U);
+      if (i > 0)
+      {
+        Rex.block(idx_u_i, idx_u_i - DIM_U, DIM_U, DIM_U) = Rlex.block(idx_u_i, 0, DIM_U, DIM_U);
+        Rex.block(idx_u_i - DIM_U, idx_u_i, DIM_U, DIM_U) = Rlex.block(idx_u_i, 0, DIM_U, DIM_U).transpose();
+      }
+    }
   }
 
-  if (Aex.array().isNaN().any() || Bex.array().isNaN().any() ||
-      Cex.array().isNaN().any() || Wex.array().isNaN().any())
+  if (Adex.array().isNaN().any() || Bdex.array().isNaN().any() ||
+      Cdex.array().isNaN().any() || Wdex.array().isNaN().any())
   {
     ROS_WARN("[MPC] calculateMPC: model matrix includes NaN, stop MPC.");
     return false;
@@ -429,28 +568,37 @@ bool MPCFollower::calculateMPC(double &vel_cmd, double &acc_cmd, double &steer_c
    * solve quadratic optimization.
    * cost function: 1/2 * Uex' * H * Uex + f' * Uex
    */
-  const Eigen::MatrixXd CB = Cex * Bex;
-  const Eigen::MatrixXd QCB = Qex * CB;
-  Eigen::MatrixXd H = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U * N);
-  H.triangularView<Eigen::Upper>() = CB.transpose() * QCB; // NOTE: This calculation is very heavy. searching for a good way...
-  H.triangularView<Eigen::Upper>() += Rex;
-  H.triangularView<Eigen::Lower>() = H.transpose();
-  Eigen::MatrixXd f = (Cex * (Aex * x0 + Wex)).transpose() * QCB - Urefex.transpose() * Rex;
-
-  /* constraint matrix : lb < U < ub, lbA < A*U < ubA */
   const double u_lim = amathutils::deg2rad(steer_lim_deg_);
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U * N);
-  Eigen::MatrixXd lbA = Eigen::MatrixXd::Zero(DIM_U * N, 1);
-  Eigen::MatrixXd ubA = Eigen::MatrixXd::Zero(DIM_U * N, 1);
-  Eigen::VectorXd lb = Eigen::VectorXd::Constant(DIM_U * N, -u_lim); // min steering angle
-  Eigen::VectorXd ub = Eigen::VectorXd::Constant(DIM_U * N, u_lim);  // max steering angle
-
   auto start = std::chrono::system_clock::now();
   Eigen::VectorXd Uex;
-  if (!qpsolver_ptr_->solve(H, f.transpose(), A, lb, ub, lbA, ubA, Uex))
+  if (is_stage_solver)
   {
-    ROS_WARN("[MPC] qp solver error");
-    return false;
+    /* solve stage by stage without building condensed matrix */
+    if (!qpsolver_ptr_->solveStage(x0, Adex, Bdex, Wdex, Cdex, Qdex, Rdex, Rlex, Urefex, Uex))
+    {
+      ROS_WARN("[MPC] qp solver error");
+      return false;
+    }
+  }
+  else
+  {
+    Eigen::MatrixXd H = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U * N);
+    Eigen::MatrixXd f = Eigen::MatrixXd::Zero(1, DIM_U * N);
+    calcCondensedQP(x0, H, f);
+
+    /* constraint matrix : lb < U < ub, lbA < A*U < ubA */
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U * N);
+    Eigen::MatrixXd lbA = Eigen::MatrixXd::Zero(DIM_U * N, 1);
+    Eigen::MatrixXd ubA = Eigen::MatrixXd::Zero(DIM_U * N, 1);
+    Eigen::VectorXd lb = Eigen::VectorXd::Constant(DIM_U * N, -u_lim); // min steering angle
+    Eigen::VectorXd ub = Eigen::VectorXd::Constant(DIM_U * N, u_lim);  // max steering angle
+
+    start = std::chrono::system_clock::now();
+    if (!qpsolver_ptr_->solve(H, f.transpose(), A, lb, ub, lbA, ubA, Uex))
+    {
+      ROS_WARN("[MPC] qp solver error");
+      return false;
+    }
   }
   double elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now() - start).count() * 1.0e-6;
   DEBUG_INFO("[MPC] calculateMPC: qp solver calculation time = %f [ms]", elapsed);
@@ -486,8 +634,16 @@ bool MPCFollower::calculateMPC(double &vel_cmd, double &acc_cmd, double &steer_c
 
   ////////////////// DEBUG ///////////////////
 
-  /* calculate predicted trajectory */
-  Eigen::VectorXd Xex = Aex * x0 + Bex * Uex + Wex;
+  /* calculate predicted trajectory, Xex = Aex * x0 + Bex * Uex + Wex step by step */
+  Eigen::VectorXd Xex(DIM_X * N);
+  Eigen::VectorXd x_pred = x0;
+  for (int i = 0; i < N; ++i)
+  {
+    const int idx_x_i = i * DIM_X;
+    x_pred = Adex.block(idx_x_i, 0, DIM_X, DIM_X) * x_pred +
+             Bdex.block(idx_x_i, 0, DIM_X, DIM_U) * Uex.segment(i * DIM_U, DIM_U) + Wdex.block(idx_x_i, 0, DIM_X, 1);
+    Xex.segment(idx_x_i, DIM_X) = x_pred;
+  }
   MPCTrajectory debug_mpc_predicted_traj;
   for (int i = 0; i < N; ++i)
   {
@@ -597,6 +753,7 @@ void MPCFollower::callbackRefPath(const autoware_msgs::Lane::ConstPtr &msg)
   }
 
   ref_traj_ = traj;
+  prev_nearest_index_ = -1;
 
   /* publish trajectory for visualize */
   visualization_msgs::Marker markers;
@@ -61,10 +61,17 @@ bool MPCUtils::interp1d(const T1 &index, const T2 &values, const double &ref, do
       return false;
     }
   }
+
+  /* binary search for the first i (>= 1) with ref <= index[i] */
   unsigned int i = 1;
-  while (ref > index[i])
+  unsigned int upper = end;
+  while (i < upper)
   {
-    ++i;
+    const unsigned int mid = (i + upper) / 2;
+    if (ref > index[mid])
+      i = mid + 1;
+    else
+      upper = mid;
   }
   const double a = ref - index[i - 1];
   const double d_index = index[i] - index[i - 1];
@@ -76,6 +83,68 @@ template bool MPCUtils::interp1d<std::vector<double>, Eigen::VectorXd>(const std
 template bool MPCUtils::interp1d<Eigen::VectorXd, std::vector<double>>(const Eigen::VectorXd &, const std::vector<double> &, const double &, double &);
 template bool MPCUtils::interp1d<Eigen::VectorXd, Eigen::VectorXd>(const Eigen::VectorXd &, const Eigen::VectorXd &, const double &, double &);
 
+template <typename T1, typename T2>
+bool MPCUtils::interp1d(const T1 &index, const T2 &values, const std::vector<double> &ref, std::vector<double> &ret)
+{
+  ret.clear();
+  if (!((int)index.size() == (int)values.size()))
+  {
+    printf("index and values must have same size, return false. size : idx = %d, values = %d\n", (int)index.size(), (int)values.size());
+    return false;
+  }
+  if (index.size() == 1)
+  {
+    printf("index size is 1, too short. return false.\n");
+    return false;
+  }
+  for (unsigned int i = 1; i < index.size(); ++i)
+  {
+    if (!(index[i] > index[i - 1]))
+    {
+      printf("index must be monotonically increasing, return false. index[%d] = %f, but index[%d] = %f\n", i, index[i], i-1, index[i - 1]);
+      return false;
+    }
+  }
+  for (unsigned int j = 1; j < ref.size(); ++j)
+  {
+    if (ref[j] < ref[j - 1])
+    {
+      printf("reference point must be increasing, return false. ref[%d] = %f, but ref[%d] = %f\n", j, ref[j], j-1, ref[j - 1]);
+      return false;
+    }
+  }
+
+  /* the search position only moves forward as the reference points are sorted */
+  const unsigned int end = index.size() - 1;
+  unsigned int i = 1;
+  ret.reserve(ref.size());
+  for (const double r : ref)
+  {
+    if (r < index[0])
+    {
+      ret.push_back(values[0]);
+      continue;
+    }
+    if (index[end] < r)
+    {
+      ret.push_back(values[end]);
+      continue;
+    }
+    while (r > index[i])
+    {
+      ++i;
+    }
+    const double a = r - index[i - 1];
+    const double d_index = index[i] - index[i - 1];
+    ret.push_back(((d_index - a) * values[i - 1] + a * values[i]) / d_index);
+  }
+  return true;
+}
+template bool MPCUtils::interp1d<std::vector<double>, std::vector<double>>(const std::vector<double> &, const std::vector<double> &, const std::vector<double> &, std::vector<double> &);
+template bool MPCUtils::interp1d<std::vector<double>, Eigen::VectorXd>(const std::vector<double> &, const Eigen::VectorXd &, const std::vector<double> &, std::vector<double> &);
+template bool MPCUtils::interp1d<Eigen::VectorXd, std::vector<double>>(const Eigen::VectorXd &, const std::vector<double> &, const std::vector<double> &, std::vector<double> &);
+template bool MPCUtils::interp1d<Eigen::VectorXd, Eigen::VectorXd>(const Eigen::VectorXd &, const Eigen::VectorXd &, const std::vector<double> &, std::vector<double> &);
+
 // 1D interpolation
 bool MPCUtils::interp1dMPCTraj(const std::vector<double> &index, const MPCTrajectory &values,
                                const std::vector<double> &ref_time, MPCTrajectory &ret)
@@ -349,22 +418,16 @@ bool MPCUtils::calcNearestPose(const MPCTrajectory &traj, const geometry_msgs::P
   return true;
 };
 
-bool MPCUtils::calcNearestPoseInterp(const MPCTrajectory &traj, const geometry_msgs::Pose &self_pose, geometry_msgs::Pose &nearest_pose,
-                                     unsigned int &nearest_index, double &min_dist_error, double &nearest_yaw_error, double &nearest_time)
+int MPCUtils::calcNearestIndex(const MPCTrajectory &traj, const geometry_msgs::Pose &self_pose, const unsigned int begin,
+                               const unsigned int end, double &min_dist_squared)
 {
-
-  if (traj.size() == 0)
-  {
-    ROS_WARN("[calcNearestPoseInterp] trajectory size is zero");
-    return false;
-  }
   const double my_x = self_pose.position.x;
   const double my_y = self_pose.position.y;
   const double my_yaw = tf2::getYaw(self_pose.orientation);
 
-  int nearest_index_tmp = -1;
-  double min_dist_squared = std::numeric_limits<double>::max();
-  for (uint i = 0; i < traj.size(); ++i)
+  int nearest_index = -1;
+  min_dist_squared = std::numeric_limits<double>::max();
+  for (uint i = begin; i < end; ++i)
   {
     const double dx = my_x - traj.x[i];
     const double dy = my_y - traj.y[i];
@@ -378,10 +441,53 @@ bool MPCUtils::calcNearestPoseInterp(const MPCTrajectory &traj, const geometry_m
       {
         /* save nearest index */
         min_dist_squared = dist_squared;
-        nearest_index_tmp = i;
+        nearest_index = i;
       }
     }
   }
+  return nearest_index;
+}
+
+bool MPCUtils::calcNearestPoseInterp(const MPCTrajectory &traj, const geometry_msgs::Pose &self_pose, geometry_msgs::Pose &nearest_pose,
+                                     unsigned int &nearest_index, double &min_dist_error, double &nearest_yaw_error, double &nearest_time)
+{
+  return calcNearestPoseInterp(traj, self_pose, -1, 0, nearest_pose, nearest_index, min_dist_error, nearest_yaw_error, nearest_time);
+}
+
+bool MPCUtils::calcNearestPoseInterp(const MPCTrajectory &traj, const geometry_msgs::Pose &self_pose, const int prev_nearest_index,
+                                     const unsigned int search_window, geometry_msgs::Pose &nearest_pose, unsigned int &nearest_index,
+                                     double &min_dist_error, double &nearest_yaw_error, double &nearest_time)
+{
+
+  if (traj.size() == 0)
+  {
+    ROS_WARN("[calcNearestPoseInterp] trajectory size is zero");
+    return false;
+  }
+  const double my_x = self_pose.position.x;
+  const double my_y = self_pose.position.y;
+  const double my_yaw = tf2::getYaw(self_pose.orientation);
+
+  int nearest_index_tmp = -1;
+  double min_dist_squared = std::numeric_limits<double>::max();
+
+  /* search around previous nearest index first */
+  if (prev_nearest_index >= 0 && prev_nearest_index < (int)traj.size())
+  {
+    const unsigned int begin = std::max(prev_nearest_index - (int)search_window, 0);
+    const unsigned int end = std::min(prev_nearest_index + search_window + 1, traj.size());
+    nearest_index_tmp = calcNearestIndex(traj, self_pose, begin, end, min_dist_squared);
+
+    /* nearest point on the window edge may not be the true one: self pose jumped, search whole trajectory */
+    if ((nearest_index_tmp == (int)begin && begin > 0) || (nearest_index_tmp == (int)end - 1 && end < traj.size()))
+    {
+      nearest_index_tmp = -1;
+    }
+  }
+  if (nearest_index_tmp == -1)
+  {
+    nearest_index_tmp = calcNearestIndex(traj, self_pose, 0, traj.size(), min_dist_squared);
+  }
   if (nearest_index_tmp == -1)
   {
     ROS_WARN("[calcNearestPoseInterp] yaw error is over PI/3 for all waypoints. no closest waypoint found.");
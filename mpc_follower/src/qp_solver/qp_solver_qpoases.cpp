@@ -17,7 +17,25 @@
 #include "mpc_follower/qp_solver/qp_solver_qpoases.h"
 
 QPSolverQpoasesHotstart::QPSolverQpoasesHotstart(const int max_iter)
-  : is_solver_initialized_(false), max_iter_(max_iter){};
+  : is_solver_initialized_(false), max_iter_(max_iter), num_variables_(0){};
+
+void QPSolverQpoasesHotstart::resize(const int num_variables)
+{
+  num_variables_ = num_variables;
+  h_matrix_.assign(num_variables * num_variables, 0.0);
+  g_vector_.assign(num_variables, 0.0);
+  lower_bound_.assign(num_variables, 0.0);
+  upper_bound_.assign(num_variables, 0.0);
+  a_constraint_matrix_.assign(num_variables * num_variables, 0.0);
+  for (int i = 0; i < num_variables; ++i)
+  {
+    a_constraint_matrix_[i * num_variables + i] = 1.0;
+  }
+
+  solver_ = qpOASES::SQProblem(num_variables, num_variables);
+  solver_.setPrintLevel(qpOASES::PL_NONE); // options: PL_DEBUG_ITER, PL_TABULAR, PL_NONE, PL_LOW, PL_MEDIUM, PL_HIGH
+  is_solver_initialized_ = false;
+}
 
 bool QPSolverQpoasesHotstart::solve(const Eigen::MatrixXd& Hmat, const Eigen::MatrixXd& fvec, const Eigen::MatrixXd& A,
                                     const Eigen::VectorXd& lb, const Eigen::VectorXd& ub, const Eigen::MatrixXd& lbA,
@@ -25,50 +43,27 @@ bool QPSolverQpoasesHotstart::solve(const Eigen::MatrixXd& Hmat, const Eigen::Ma
 {
   int max_iter = max_iter_; // redeclaration to give a non-const value to solver
 
-  const int kNumOfMatrixElements = Hmat.rows() * Hmat.cols();
-  double h_matrix[kNumOfMatrixElements];
-
   const int kNumOfOffsetRows = fvec.rows();
-  double g_matrix[kNumOfOffsetRows];
-
-  double lower_bound[kNumOfOffsetRows];
-  double upper_bound[kNumOfOffsetRows];
-
-  double result[kNumOfOffsetRows];
-  U = Eigen::VectorXd::Zero(kNumOfOffsetRows);
-
-  Eigen::MatrixXd Aconstraint = Eigen::MatrixXd::Identity(kNumOfOffsetRows, kNumOfOffsetRows);
-  double a_constraint_matirx[kNumOfMatrixElements];
-
-  int index = 0;
-
-  for (int r = 0; r < Hmat.rows(); ++r)
-  {
-    g_matrix[r] = fvec(r, 0);
-    for (int c = 0; c < Hmat.cols(); ++c)
-    {
-      h_matrix[index] = Hmat(r, c);
-      a_constraint_matirx[index] = Aconstraint(r, c);
-      index++;
-    }
-  }
-
-  for (int i = 0; i < kNumOfOffsetRows; ++i)
+  if (kNumOfOffsetRows != num_variables_)
   {
-    lower_bound[i] = lb[i];
-    upper_bound[i] = ub[i];
+    resize(kNumOfOffsetRows);
   }
 
-  solver_.setPrintLevel(qpOASES::PL_NONE); // options: PL_DEBUG_ITER, PL_TABULAR, PL_NONE, PL_LOW, PL_MEDIUM, PL_HIGH
+  /* only hessian, gradient and bounds change between calls */
+  using RowMajorMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  Eigen::Map<RowMajorMatrix>(h_matrix_.data(), kNumOfOffsetRows, kNumOfOffsetRows) = Hmat;
+  Eigen::Map<Eigen::VectorXd>(g_vector_.data(), kNumOfOffsetRows) = fvec.col(0);
+  Eigen::Map<Eigen::VectorXd>(lower_bound_.data(), kNumOfOffsetRows) = lb;
+  Eigen::Map<Eigen::VectorXd>(upper_bound_.data(), kNumOfOffsetRows) = ub;
 
   if (!is_solver_initialized_)
   {
-    solver_ = qpOASES::SQProblem(kNumOfOffsetRows, kNumOfOffsetRows);
-    auto ret = solver_.init(h_matrix, g_matrix, a_constraint_matirx, lower_bound, upper_bound, lower_bound, upper_bound,
-                            max_iter);
+    auto ret = solver_.init(h_matrix_.data(), g_vector_.data(), a_constraint_matrix_.data(), lower_bound_.data(),
+                            upper_bound_.data(), lower_bound_.data(), upper_bound_.data(), max_iter);
     if (ret != qpOASES::SUCCESSFUL_RETURN)
     {
       std::cerr << "[QPOASES] not successfully solved in init()" << std::endl;
+      num_variables_ = 0; // set up solver_ again in the next call
       return false;
     }
 
@@ -76,8 +71,9 @@ bool QPSolverQpoasesHotstart::solve(const Eigen::MatrixXd& Hmat, const Eigen::Ma
   }
   else
   {
-    auto ret = solver_.hotstart(h_matrix, g_matrix, a_constraint_matirx, lower_bound, upper_bound, lower_bound,
-                                upper_bound, max_iter);
+    /* warm start from the active set of the previous solution */
+    auto ret = solver_.hotstart(h_matrix_.data(), g_vector_.data(), a_constraint_matrix_.data(), lower_bound_.data(),
+                                upper_bound_.data(), lower_bound_.data(), upper_bound_.data(), max_iter);
     if (ret != qpOASES::SUCCESSFUL_RETURN)
     {
       std::cerr << "[QPOASES] not successfully solved in hotstart()" << std::endl;
@@ -85,12 +81,8 @@ bool QPSolverQpoasesHotstart::solve(const Eigen::MatrixXd& Hmat, const Eigen::Ma
     }
   }
 
-  solver_.getPrimalSolution(result);
-
-  for (int i = 0; i < kNumOfOffsetRows; ++i)
-  {
-    U(i) = result[i];
-  }
+  U.resize(kNumOfOffsetRows);
+  solver_.getPrimalSolution(U.data());
 
   return true;
 };
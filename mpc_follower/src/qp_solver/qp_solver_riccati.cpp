@@ -0,0 +1,135 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mpc_follower/qp_solver/qp_solver_riccati.h"
+
+QPSolverRiccati::QPSolverRiccati(){};
+
+bool QPSolverRiccati::solve(const Eigen::MatrixXd &Hmat, const Eigen::MatrixXd &fvec, const Eigen::MatrixXd &A,
+                            const Eigen::VectorXd &lb, const Eigen::VectorXd &ub, const Eigen::MatrixXd &lbA,
+                            const Eigen::MatrixXd &ubA, Eigen::VectorXd &U)
+{
+  llt_.compute(Hmat);
+  if (llt_.info() != Eigen::Success)
+    return false;
+
+  U = -fvec;
+  llt_.solveInPlace(U);
+
+  return true;
+};
+
+bool QPSolverRiccati::solveStage(const Eigen::VectorXd &x0, const Eigen::MatrixXd &Adex, const Eigen::MatrixXd &Bdex,
+                                 const Eigen::MatrixXd &Wdex, const Eigen::MatrixXd &Cdex, const Eigen::MatrixXd &Qdex,
+                                 const Eigen::MatrixXd &Rdex, const Eigen::MatrixXd &Rlex, const Eigen::MatrixXd &Urefex,
+                                 Eigen::VectorXd &U)
+{
+  const int DIM_X = Adex.cols();
+  if (DIM_X == 0 || Adex.rows() == 0)
+    return false;
+  const int N = Adex.rows() / DIM_X;
+  const int DIM_U = Urefex.rows() / N;
+  const int DIM_Y = Qdex.cols();
+  const int DIM_Z = DIM_X + DIM_U;
+
+  /*
+   * augmented state z(i) = [x(i); u(i-1)] : z(i+1) = Az * z(i) + Bz * u(i) + Wz
+   * Az = [Ad(i), 0; 0, 0], Bz = [Bd(i); I], Wz = [Wd(i); 0]
+   * value function from step i : V(z) = z' * P * z + 2 * q' * z + const, V = 0 after the last step
+   */
+  K_.resize(DIM_U * N, DIM_Z);
+  k_.resize(DIM_U * N);
+  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(DIM_Z, DIM_Z);
+  Eigen::VectorXd q = Eigen::VectorXd::Zero(DIM_Z);
+  Eigen::MatrixXd S(DIM_Z, DIM_Z);
+  Eigen::MatrixXd Az = Eigen::MatrixXd::Zero(DIM_Z, DIM_Z);
+  Eigen::MatrixXd Bz = Eigen::MatrixXd::Zero(DIM_Z, DIM_U);
+  Eigen::VectorXd Wz = Eigen::VectorXd::Zero(DIM_Z);
+  Bz.bottomRows(DIM_U) = Eigen::MatrixXd::Identity(DIM_U, DIM_U);
+  Eigen::MatrixXd SB(DIM_Z, DIM_U);
+  Eigen::MatrixXd Hu(DIM_U, DIM_U);
+  Eigen::MatrixXd G(DIM_U, DIM_Z);
+  Eigen::VectorXd s(DIM_Z);
+  Eigen::VectorXd h(DIM_U);
+  Eigen::LLT<Eigen::MatrixXd> llt(DIM_U);
+
+  for (int i = N - 1; i >= 0; --i)
+  {
+    const int idx_x_i = i * DIM_X;
+    const int idx_u_i = i * DIM_U;
+    const int idx_y_i = i * DIM_Y;
+    const auto Cd = Cdex.block(idx_y_i, 0, DIM_Y, DIM_X);
+    const auto Qd = Qdex.block(idx_y_i, 0, DIM_Y, DIM_Y);
+    Az.topLeftCorner(DIM_X, DIM_X) = Adex.block(idx_x_i, 0, DIM_X, DIM_X);
+    Bz.topRows(DIM_X) = Bdex.block(idx_x_i, 0, DIM_X, DIM_U);
+    Wz.head(DIM_X) = Wdex.block(idx_x_i, 0, DIM_X, 1);
+
+    /* cost of z(i+1) : output cost of x(i+1) and value function */
+    S = P;
+    S.topLeftCorner(DIM_X, DIM_X) += Cd.transpose() * Qd * Cd;
+
+    /* (Rex * Urefex)(i) as linear term of input cost, Rex(i, i+1) = Rl(i+1)' */
+    Eigen::VectorXd r = Rdex.block(idx_u_i, 0, DIM_U, DIM_U) * Urefex.block(idx_u_i, 0, DIM_U, 1);
+    if (i > 0)
+      r += Rlex.block(idx_u_i, 0, DIM_U, DIM_U) * Urefex.block(idx_u_i - DIM_U, 0, DIM_U, 1);
+    if (i < N - 1)
+      r += Rlex.block(idx_u_i + DIM_U, 0, DIM_U, DIM_U).transpose() * Urefex.block(idx_u_i + DIM_U, 0, DIM_U, 1);
+
+    /* stage cost in u(i) : u' * Hu * u + 2 * u' * (G * z + h) */
+    SB.noalias() = S * Bz;
+    Hu = Rdex.block(idx_u_i, 0, DIM_U, DIM_U);
+    Hu.noalias() += Bz.transpose() * SB;
+    G.noalias() = SB.transpose() * Az;
+    if (i > 0)
+      G.rightCols(DIM_U) += Rlex.block(idx_u_i, 0, DIM_U, DIM_U);
+    s = q;
+    s.noalias() += S * Wz;
+    h = -r;
+    h.noalias() += Bz.transpose() * s;
+
+    llt.compute(Hu);
+    if (llt.info() != Eigen::Success)
+      return false;
+
+    /* u(i) = K(i) * z(i) + k(i) */
+    auto K = K_.block(idx_u_i, 0, DIM_U, DIM_Z);
+    auto k = k_.segment(idx_u_i, DIM_U);
+    K = -llt.solve(G);
+    k = -llt.solve(h);
+
+    /* P = Az' * S * Az - G' * Hu^-1 * G, q = Az' * s - G' * Hu^-1 * h */
+    P = Az.transpose() * S * Az + G.transpose() * K;
+    q = Az.transpose() * s + G.transpose() * k;
+  }
+
+  /* forward simulation with the optimal feedback, u(-1) has no cost */
+  U.resize(DIM_U * N);
+  Eigen::VectorXd x = x0;
+  Eigen::VectorXd z = Eigen::VectorXd::Zero(DIM_Z);
+  for (int i = 0; i < N; ++i)
+  {
+    const int idx_x_i = i * DIM_X;
+    const int idx_u_i = i * DIM_U;
+    z.head(DIM_X) = x;
+    const Eigen::VectorXd u = K_.block(idx_u_i, 0, DIM_U, DIM_Z) * z + k_.segment(idx_u_i, DIM_U);
+    U.segment(idx_u_i, DIM_U) = u;
+    x = Adex.block(idx_x_i, 0, DIM_X, DIM_X) * x + Bdex.block(idx_x_i, 0, DIM_X, DIM_U) * u +
+        Wdex.block(idx_x_i, 0, DIM_X, 1);
+    z.tail(DIM_U) = u;
+  }
+
+  return true;
+};
@@ -21,10 +21,13 @@ bool QPSolverEigenLeastSquareLLT::solve(const Eigen::MatrixXd &Hmat, const Eigen
                                         const Eigen::VectorXd &lb, const Eigen::VectorXd &ub, const Eigen::MatrixXd &lbA,
                                         const Eigen::MatrixXd &ubA, Eigen::VectorXd &U)
 {
-     if (std::fabs(Hmat.determinant()) < 1.0E-9)
+     /* factorization fails when Hmat is not positive definite */
+     llt_.compute(Hmat);
+     if (llt_.info() != Eigen::Success)
           return false;
 
-     U = -Hmat.llt().solve(fvec);
+     U = -fvec;
+     llt_.solveInPlace(U);
 
      return true;
 };
@@ -18,7 +18,7 @@
 
 DynamicsBicycleModel::DynamicsBicycleModel(double &wheelbase, double &mass_fl, double &mass_fr,
                                            double &mass_rl, double &mass_rr, double &cf, double &cr)
-    : VehicleModelInterface(/* dim_x */ 4, /* dim_u */ 1, /* dim_y */ 2)
+    : VehicleModelFixedSize() /* dim_x = 4, dim_u = 1, dim_y = 2 */
 {
     wheelbase_ = wheelbase;
 
@@ -33,11 +33,11 @@ DynamicsBicycleModel::DynamicsBicycleModel(double &wheelbase, double &mass_fl, d
     cr_ = cr;
 };
 
-void DynamicsBicycleModel::calculateDiscreteMatrix(Eigen::MatrixXd &Ad,
-                                                   Eigen::MatrixXd &Bd,
-                                                   Eigen::MatrixXd &Cd,
-                                                   Eigen::MatrixXd &Wd,
-                                                   const double &dt)
+void DynamicsBicycleModel::calculateDiscreteMatrixFixed(MatrixA &Ad,
+                                                        MatrixB &Bd,
+                                                        MatrixC &Cd,
+                                                        MatrixW &Wd,
+                                                        const double &dt)
 {
     /*
      * x[k+1] = Ad*x[k] + Bd*u + Wd
@@ -45,7 +45,7 @@ void DynamicsBicycleModel::calculateDiscreteMatrix(Eigen::MatrixXd &Ad,
 
     const double vel = std::max(velocity_, 0.01);
 
-    Ad = Eigen::MatrixXd::Zero(dim_x_, dim_x_);
+    Ad = MatrixA::Zero();
     Ad(0, 1) = 1.0;
     Ad(1, 1) = -(cf_ + cr_) / (mass_ * vel);
     Ad(1, 2) = (cf_ + cr_) / mass_;
@@ -55,18 +55,18 @@ void DynamicsBicycleModel::calculateDiscreteMatrix(Eigen::MatrixXd &Ad,
     Ad(3, 2) = (lf_ * cf_ - lr_ * cr_) / iz_;
     Ad(3, 3) = -(lf_ * lf_ * cf_ + lr_ * lr_ * cr_) / (iz_ * vel);
 
-    Eigen::MatrixXd I = Eigen::MatrixXd::Identity(dim_x_, dim_x_);
-    Eigen::MatrixXd Ad_inverse = (I - dt * 0.5 * Ad).inverse();
+    const MatrixA I = MatrixA::Identity();
+    const MatrixA Ad_inverse = (I - dt * 0.5 * Ad).inverse();
 
     Ad = Ad_inverse * (I + dt * 0.5 * Ad); // bilinear discretization
 
-    Bd = Eigen::MatrixXd::Zero(dim_x_, dim_u_);
+    Bd = MatrixB::Zero();
     Bd(0, 0) = 0.0;
     Bd(1, 0) = cf_ / mass_;
     Bd(2, 0) = 0.0;
     Bd(3, 0) = lf_ * cf_ / iz_;
 
-    Wd = Eigen::MatrixXd::Zero(dim_x_, 1);
+    Wd = MatrixW::Zero();
     Wd(0, 0) = 0.0;
     Wd(1, 0) = (lr_ * cr_ - lf_ * cf_) / (mass_ * vel) - vel;
     Wd(2, 0) = 0.0;
@@ -75,7 +75,7 @@ void DynamicsBicycleModel::calculateDiscreteMatrix(Eigen::MatrixXd &Ad,
     Bd = (Ad_inverse * dt) * Bd;
     Wd = (Ad_inverse * dt * curvature_ * vel) * Wd;
 
-    Cd = Eigen::MatrixXd::Zero(dim_y_, dim_x_);
+    Cd = MatrixC::Zero();
     Cd(0, 0) = 1.0;
     Cd(1, 2) = 1.0;
 }
@@ -17,15 +17,15 @@
 #include "mpc_follower/vehicle_model/vehicle_model_bicycle_kinematics.h"
 
 KinematicsBicycleModel::KinematicsBicycleModel(const double &wheelbase, const double &steer_lim, const double &steer_tau)
-    : VehicleModelInterface(/* dim_x */ 3, /* dim_u */ 1, /* dim_y */ 2)
+    : VehicleModelFixedSize() /* dim_x = 3, dim_u = 1, dim_y = 2 */
 {
     wheelbase_ = wheelbase;
     steer_lim_ = steer_lim;
     steer_tau_ = steer_tau;
 };
 
-void KinematicsBicycleModel::calculateDiscreteMatrix(Eigen::MatrixXd &Ad, Eigen::MatrixXd &Bd,
-                                                     Eigen::MatrixXd &Cd, Eigen::MatrixXd &Wd, const double &dt)
+void KinematicsBicycleModel::calculateDiscreteMatrixFixed(MatrixA &Ad, MatrixB &Bd, MatrixC &Cd, MatrixW &Wd,
+                                                          const double &dt)
 {
     auto sign = [](double x) { return (x > 0.0) - (x < 0.0); };
 
@@ -38,7 +38,7 @@ void KinematicsBicycleModel::calculateDiscreteMatrix(Eigen::MatrixXd &Ad, Eigen:
     Ad << 0.0, velocity_, 0.0,
         0.0, 0.0, velocity_ / wheelbase_ * cos_delta_r_squared_inv,
         0.0, 0.0, -1.0 / steer_tau_;
-    Eigen::MatrixXd I = Eigen::MatrixXd::Identity(dim_x_, dim_x_);
+    const MatrixA I = MatrixA::Identity();
     Ad = (I - dt * 0.5 * Ad).inverse() * (I + dt * 0.5 * Ad); // bilinear discretization
 
     Bd << 0.0, 0.0, 1.0 / steer_tau_;
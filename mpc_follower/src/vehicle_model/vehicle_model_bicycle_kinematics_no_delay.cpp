@@ -18,13 +18,13 @@
 #include "mpc_follower/vehicle_model/vehicle_model_bicycle_kinematics_no_delay.h"
 
 KinematicsBicycleModelNoDelay::KinematicsBicycleModelNoDelay(const double &wheelbase, const double &steer_lim)
-    : VehicleModelInterface(/* dim_x */ 2, /* dim_u */ 1, /* dim_y */ 2)
+    : VehicleModelFixedSize() /* dim_x = 2, dim_u = 1, dim_y = 2 */
 {
     wheelbase_ = wheelbase;
     steer_lim_ = steer_lim;
 };
-void KinematicsBicycleModelNoDelay::calculateDiscreteMatrix(Eigen::MatrixXd &Ad, Eigen::MatrixXd &Bd,
-                                                     Eigen::MatrixXd &Cd, Eigen::MatrixXd &Wd, const double &dt)
+void KinematicsBicycleModelNoDelay::calculateDiscreteMatrixFixed(MatrixA &Ad, MatrixB &Bd, MatrixC &Cd, MatrixW &Wd,
+                                                                 const double &dt)
 {
     auto sign = [](double x) { return (x > 0.0) - (x < 0.0); };
 
@@ -36,7 +36,7 @@ void KinematicsBicycleModelNoDelay::calculateDiscreteMatrix(Eigen::MatrixXd &Ad,
 
     Ad << 0.0, velocity_,
           0.0, 0.0;
-    Eigen::MatrixXd I = Eigen::MatrixXd::Identity(dim_x_, dim_x_);
+    const MatrixA I = MatrixA::Identity();
     Ad = I + Ad * dt;
 
     Bd << 0.0, velocity_ / wheelbase_ * cos_delta_r_squared_inv;
@@ -18,10 +18,13 @@
 #include <cmath>
 #include <gtest/gtest.h>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <autoware_msgs/Lane.h>
 #include <autoware_msgs/VehicleStatus.h>
 #include <autoware_msgs/ControlCommand.h>
+#include <std_msgs/Float32.h>
 #include <amathutils_lib/amathutils.hpp>
 #include "amathutils_lib/amathutils.hpp"
 #include "mpc_follower/mpc_utils.h"
@@ -50,11 +53,16 @@ public:
     autoware_msgs::ControlCommandStamped ctrl_cmd_;
     double spin_duration_;
     int spin_loopnum_;
+    std::vector<double> mpc_calc_time_;
 
     void callbackTwistRaw(const geometry_msgs::TwistStamped &twist)
     {
         twist_raw_ = twist;
     }
+    void callbackMPCCalcTime(const std_msgs::Float32 &msg)
+    {
+        mpc_calc_time_.push_back(msg.data);
+    }
     void callbackCtrlCmd(const autoware_msgs::ControlCommandStamped &cmd)
     {
         ctrl_cmd_ = cmd;
@@ -317,7 +325,45 @@ TEST_F(TestSuite, TestMPCFollower)
 
 }
 
+/* benchmark, not run by default : --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* */
+TEST_F(TestSuite, DISABLED_BenchmarkMPCCalcTime)
+{
+    ros::Subscriber sub_calc_time = pnh_.subscribe("debug/mpc_calc_time", 100, &TestSuite::callbackMPCCalcTime, this);
+    pnh_.setParam("vehicle_model_type", "kinematics");
 
+    for (const std::string qp_solver_type : {"unconstraint_fast", "riccati"})
+    {
+        pnh_.setParam("qp_solver_type", qp_solver_type);
+        for (const int N : {10, 50, 100, 200})
+        {
+            pnh_.setParam("mpc_prediction_horizon", N);
+            MPCFollower mpc_follower;
+
+            geometry_msgs::PoseStamped current_pose;
+            current_pose.pose.position.y = 1.0;
+            current_pose.pose.orientation.w = 1.0;
+            autoware_msgs::VehicleStatus vs;
+            vs.speed = 3.0;
+            vs.angle = 0.0;
+
+            /* path of 50 [s], longer than the longest prediction of 20 [s] */
+            mpc_calc_time_.clear();
+            publishMsgs(current_pose, vs, 3.0, 0.05, 1.0, 0.0, 0.0, 0.0);
+            ros::spinOnce();
+
+            /* the first cycle also allocates the matrices */
+            ASSERT_GT(mpc_calc_time_.size(), 1U) << "no mpc_calc_time is published";
+            double sum = 0.0;
+            for (size_t i = 1; i < mpc_calc_time_.size(); ++i)
+                sum += mpc_calc_time_[i];
+            std::cout << qp_solver_type << ", N = " << N << " : calculateMPC " << sum / (mpc_calc_time_.size() - 1)
+                      << " ms, first cycle " << mpc_calc_time_.front() << " ms" << std::endl;
+        }
+    }
+
+    pnh_.deleteParam("mpc_prediction_horizon");
+    pnh_.setParam("qp_solver_type", "unconstraint_fast");
+}
 
 int main(int argc, char **argv)
 {
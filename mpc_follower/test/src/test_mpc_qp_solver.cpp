@@ -0,0 +1,285 @@
+/*
+ * Copyright 2018-2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ros/ros.h>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <iostream>
+
+#include "mpc_follower/vehicle_model/vehicle_model_bicycle_kinematics.h"
+#include "mpc_follower/qp_solver/qp_solver_unconstr_fast.h"
+#include "mpc_follower/qp_solver/qp_solver_riccati.h"
+
+class TestSuite : public ::testing::Test
+{
+public:
+    TestSuite() {}
+    ~TestSuite() {}
+
+    /* kinematics model problem with horizon N, condensed for the LLT solver and stage-wise for the riccati solver */
+    struct Problem
+    {
+        Eigen::MatrixXd Adex, Bdex, Wdex, Cdex, Qdex, Rdex, Rlex, Urefex;
+        Eigen::MatrixXd Aex, Bex, Wex, Cex, Qex, Rex;
+        Eigen::MatrixXd H, f;
+        Eigen::VectorXd x0;
+    };
+
+    void createProblem(const int N, Problem &p)
+    {
+        KinematicsBicycleModel model(2.9 /* wheelbase */, 0.61 /* steer_lim */, 0.3 /* steer_tau */);
+        const int DIM_X = model.getDimX();
+        const int DIM_U = model.getDimU();
+        const int DIM_Y = model.getDimY();
+        const double DT = 0.1;
+
+        Eigen::MatrixXd &Aex = p.Aex;
+        Eigen::MatrixXd &Bex = p.Bex;
+        Eigen::MatrixXd &Wex = p.Wex;
+        Eigen::MatrixXd &Cex = p.Cex;
+        Eigen::MatrixXd &Qex = p.Qex;
+        Eigen::MatrixXd &Rex = p.Rex;
+        Aex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_X);
+        Bex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_U * N);
+        Wex = Eigen::MatrixXd::Zero(DIM_X * N, 1);
+        Cex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_X * N);
+        Qex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_Y * N);
+        Rex = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U * N);
+        p.Adex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_X);
+        p.Bdex = Eigen::MatrixXd::Zero(DIM_X * N, DIM_U);
+        p.Wdex = Eigen::MatrixXd::Zero(DIM_X * N, 1);
+        p.Urefex = Eigen::MatrixXd::Zero(DIM_U * N, 1);
+
+        Eigen::MatrixXd Ad(DIM_X, DIM_X), Bd(DIM_X, DIM_U), Cd(DIM_Y, DIM_X), Wd(DIM_X, 1), Uref(DIM_U, 1);
+        for (int i = 0; i < N; ++i)
+        {
+            const double v = 5.0 + 0.05 * i;
+            model.setVelocity(v);
+            model.setCurvature(0.05 * std::sin(0.1 * i));
+            model.calculateDiscreteMatrix(Ad, Bd, Cd, Wd, DT);
+            model.calculateReferenceInput(Uref);
+
+            const int idx_x_i = i * DIM_X;
+            const int idx_u_i = i * DIM_U;
+            const int idx_y_i = i * DIM_Y;
+            if (i == 0)
+            {
+                Aex.block(0, 0, DIM_X, DIM_X) = Ad;
+                Wex.block(0, 0, DIM_X, 1) = Wd;
+            }
+            else
+            {
+                Aex.block(idx_x_i, 0, DIM_X, DIM_X) = Ad * Aex.block(idx_x_i - DIM_X, 0, DIM_X, DIM_X);
+                Bex.block(idx_x_i, 0, DIM_X, idx_u_i) = Ad * Bex.block(idx_x_i - DIM_X, 0, DIM_X, idx_u_i);
+                Wex.block(idx_x_i, 0, DIM_X, 1) = Ad * Wex.block(idx_x_i - DIM_X, 0, DIM_X, 1) + Wd;
+            }
+            Bex.block(idx_x_i, idx_u_i, DIM_X, DIM_U) = Bd;
+            p.Adex.block(idx_x_i, 0, DIM_X, DIM_X) = Ad;
+            p.Bdex.block(idx_x_i, 0, DIM_X, DIM_U) = Bd;
+            p.Wdex.block(idx_x_i, 0, DIM_X, 1) = Wd;
+            Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X) = Cd;
+            Qex(idx_y_i, idx_y_i) = (i == N - 1) ? 1.0 : 0.1;
+            Qex(idx_y_i + 1, idx_y_i + 1) = 0.3 * v * v;
+            Rex(idx_u_i, idx_u_i) = 1.0 + 0.25 * v * v;
+            p.Urefex.block(idx_u_i, 0, DIM_U, 1) = Uref;
+        }
+
+        /* lateral jerk couples neighboring inputs */
+        for (int i = 0; i < N - 1; ++i)
+        {
+            const double w = 0.1 * (5.0 + 0.05 * i) * (5.0 + 0.05 * i);
+            Rex(i, i) += w;
+            Rex(i + 1, i) -= w;
+            Rex(i, i + 1) -= w;
+            Rex(i + 1, i + 1) += w;
+        }
+
+        /* stage-wise blocks for the riccati solver */
+        p.Cdex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_X);
+        p.Qdex = Eigen::MatrixXd::Zero(DIM_Y * N, DIM_Y);
+        p.Rdex = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U);
+        p.Rlex = Eigen::MatrixXd::Zero(DIM_U * N, DIM_U);
+        for (int i = 0; i < N; ++i)
+        {
+            p.Cdex.block(i * DIM_Y, 0, DIM_Y, DIM_X) = Cex.block(i * DIM_Y, i * DIM_X, DIM_Y, DIM_X);
+            p.Qdex.block(i * DIM_Y, 0, DIM_Y, DIM_Y) = Qex.block(i * DIM_Y, i * DIM_Y, DIM_Y, DIM_Y);
+            p.Rdex.block(i * DIM_U, 0, DIM_U, DIM_U) = Rex.block(i * DIM_U, i * DIM_U, DIM_U, DIM_U);
+            if (i > 0)
+                p.Rlex.block(i * DIM_U, 0, DIM_U, DIM_U) = Rex.block(i * DIM_U, (i - 1) * DIM_U, DIM_U, DIM_U);
+        }
+
+        p.x0 = Eigen::VectorXd(DIM_X);
+        p.x0 << 0.5, -0.1, 0.02;
+
+        condense(p);
+    }
+
+    /* condensed problem as built by MPCFollower for the LLT solver */
+    void condense(Problem &p)
+    {
+        const Eigen::MatrixXd CB = p.Cex * p.Bex;
+        const Eigen::MatrixXd QCB = p.Qex * CB;
+        p.H = CB.transpose() * QCB + p.Rex;
+        p.f = ((p.Cex * (p.Aex * p.x0 + p.Wex)).transpose() * QCB - p.Urefex.transpose() * p.Rex).transpose();
+    }
+
+    /* average time of fn in microseconds */
+    template <typename Fn>
+    double measure(const int repeat, Fn fn)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeat; ++i)
+            fn();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::micro>(end - start).count() / repeat;
+    }
+};
+
+TEST_F(TestSuite, TestRiccatiSameAsLLT)
+{
+    for (const int N : {10, 70, 200})
+    {
+        Problem p;
+        createProblem(N, p);
+        const int DIM_U_N = p.Urefex.rows();
+        const Eigen::MatrixXd A = Eigen::MatrixXd::Zero(DIM_U_N, DIM_U_N);
+        const Eigen::MatrixXd lbA = Eigen::MatrixXd::Zero(DIM_U_N, 1);
+        const Eigen::VectorXd lb = Eigen::VectorXd::Constant(DIM_U_N, -0.61);
+        const Eigen::VectorXd ub = Eigen::VectorXd::Constant(DIM_U_N, 0.61);
+
+        Eigen::VectorXd U_llt, U_riccati;
+        QPSolverEigenLeastSquareLLT llt_solver;
+        QPSolverRiccati riccati_solver;
+        ASSERT_TRUE(llt_solver.solve(p.H, p.f, A, lb, ub, lbA, lbA, U_llt));
+        ASSERT_TRUE(riccati_solver.isStageSolver());
+        ASSERT_TRUE(riccati_solver.solveStage(p.x0, p.Adex, p.Bdex, p.Wdex, p.Cdex, p.Qdex, p.Rdex, p.Rlex, p.Urefex,
+                                              U_riccati));
+
+        ASSERT_EQ(U_llt.size(), U_riccati.size());
+        for (int i = 0; i < U_llt.size(); ++i)
+        {
+            ASSERT_NEAR(U_llt(i), U_riccati(i), 1.0E-8) << "N = " << N << ", i = " << i;
+        }
+    }
+}
+
+TEST_F(TestSuite, TestLLTPositiveDefiniteCheck)
+{
+    const int N = 20;
+    const Eigen::MatrixXd A = Eigen::MatrixXd::Zero(N, N);
+    const Eigen::MatrixXd lbA = Eigen::MatrixXd::Zero(N, 1);
+    const Eigen::VectorXd lb = Eigen::VectorXd::Constant(N, -1.0);
+    const Eigen::VectorXd ub = Eigen::VectorXd::Constant(N, 1.0);
+    const Eigen::MatrixXd f = Eigen::MatrixXd::Constant(N, 1, 0.01);
+    QPSolverEigenLeastSquareLLT llt_solver;
+    Eigen::VectorXd U;
+
+    /* positive definite with small determinant (1.0E-40) */
+    const Eigen::MatrixXd H_small = 0.01 * Eigen::MatrixXd::Identity(N, N);
+    ASSERT_TRUE(llt_solver.solve(H_small, f, A, lb, ub, lbA, lbA, U));
+    ASSERT_EQ(N, U.size());
+    for (int i = 0; i < N; ++i)
+    {
+        ASSERT_NEAR(-1.0, U(i), 1.0E-12);
+    }
+
+    /* singular */
+    Eigen::MatrixXd H_singular = Eigen::MatrixXd::Identity(N, N);
+    H_singular(N - 1, N - 1) = 0.0;
+    ASSERT_FALSE(llt_solver.solve(H_singular, f, A, lb, ub, lbA, lbA, U));
+
+    /* indefinite */
+    Eigen::MatrixXd H_indefinite = Eigen::MatrixXd::Identity(N, N);
+    H_indefinite(0, 0) = -1.0;
+    ASSERT_FALSE(llt_solver.solve(H_indefinite, f, A, lb, ub, lbA, lbA, U));
+
+    /* solver recovers after failure */
+    ASSERT_TRUE(llt_solver.solve(H_small, f, A, lb, ub, lbA, lbA, U));
+    ASSERT_NEAR(-1.0, U(0), 1.0E-12);
+}
+
+/* benchmark, not run by default : --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* */
+TEST_F(TestSuite, DISABLED_BenchmarkLLT)
+{
+    const int repeat = 100;
+    for (const int N : {50, 100, 200})
+    {
+        Problem p;
+        createProblem(N, p);
+        const int DIM_U_N = p.Urefex.rows();
+        const Eigen::MatrixXd A = Eigen::MatrixXd::Zero(DIM_U_N, DIM_U_N);
+        const Eigen::MatrixXd lbA = Eigen::MatrixXd::Zero(DIM_U_N, 1);
+        const Eigen::VectorXd lb = Eigen::VectorXd::Constant(DIM_U_N, -0.61);
+        const Eigen::VectorXd ub = Eigen::VectorXd::Constant(DIM_U_N, 0.61);
+
+        /* determinant precheck before the factorization, as the LLT solver did before */
+        Eigen::VectorXd U_det;
+        const double t_det = measure(repeat, [&]() {
+            if (std::fabs(p.H.determinant()) >= 1.0E-9)
+                U_det = -p.H.llt().solve(p.f);
+        });
+
+        QPSolverEigenLeastSquareLLT llt_solver;
+        Eigen::VectorXd U_llt;
+        const double t_llt = measure(repeat, [&]() { llt_solver.solve(p.H, p.f, A, lb, ub, lbA, lbA, U_llt); });
+
+        std::cout << "N = " << N << " : determinant + LLT " << t_det << " us, LLT " << t_llt << " us" << std::endl;
+        ASSERT_TRUE(U_llt.isApprox(U_det));
+    }
+}
+
+/* benchmark, not run by default : --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* */
+TEST_F(TestSuite, DISABLED_BenchmarkRiccati)
+{
+    for (const int N : {10, 25, 50, 100, 200})
+    {
+        const int repeat = (N < 100) ? 100 : 10;
+        Problem p;
+        createProblem(N, p);
+        const int DIM_U_N = p.Urefex.rows();
+        const Eigen::MatrixXd A = Eigen::MatrixXd::Zero(DIM_U_N, DIM_U_N);
+        const Eigen::MatrixXd lbA = Eigen::MatrixXd::Zero(DIM_U_N, 1);
+        const Eigen::VectorXd lb = Eigen::VectorXd::Constant(DIM_U_N, -0.61);
+        const Eigen::VectorXd ub = Eigen::VectorXd::Constant(DIM_U_N, 0.61);
+
+        /* the condensed solvers also need H and f */
+        QPSolverEigenLeastSquareLLT llt_solver;
+        Eigen::VectorXd U_llt;
+        const double t_llt = measure(repeat, [&]() {
+            condense(p);
+            llt_solver.solve(p.H, p.f, A, lb, ub, lbA, lbA, U_llt);
+        });
+
+        QPSolverRiccati riccati_solver;
+        Eigen::VectorXd U_riccati;
+        const double t_riccati = measure(repeat, [&]() {
+            riccati_solver.solveStage(p.x0, p.Adex, p.Bdex, p.Wdex, p.Cdex, p.Qdex, p.Rdex, p.Rlex, p.Urefex,
+                                      U_riccati);
+        });
+
+        std::cout << "N = " << N << " : condense + LLT " << t_llt << " us, riccati " << t_riccati << " us"
+                  << std::endl;
+        ASSERT_TRUE(U_llt.isApprox(U_riccati, 1.0E-6));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    ros::init(argc, argv, "TestNode");
+    return RUN_ALL_TESTS();
+}
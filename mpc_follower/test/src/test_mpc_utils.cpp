@@ -70,6 +70,41 @@ TEST(TestSuite, InterpolationTest){
     ASSERT_DOUBLE_EQ(-1.4, ret);
 }
 
+TEST(TestSuite, SortedInterpolationTest){
+
+    std::vector<double> idx;
+    std::vector<double> value;
+    for (int i = 0; i < 100; ++i) {
+        idx.push_back(0.1 * i + 0.001 * i * i);
+        value.push_back(std::sin(0.3 * i));
+    }
+    Eigen::VectorXd value_eigen = Eigen::Map<Eigen::VectorXd>(value.data(), value.size());
+
+    /* includes out of range points, exact knots and repeated points */
+    std::vector<double> ref = {-1.0, 0.0, 0.05, 0.1, 0.1, 3.7, idx[50], 12.0, idx.back(), 100.0};
+    std::vector<double> ret;
+    ASSERT_EQ(true, MPCUtils::interp1d(idx, value, ref, ret));
+    ASSERT_EQ(ref.size(), ret.size());
+    for (unsigned int i = 0; i < ref.size(); ++i) {
+        double ret_single = 0.0;
+        MPCUtils::interp1d(idx, value, ref[i], ret_single);
+        ASSERT_DOUBLE_EQ(ret_single, ret[i]) << "i = " << i;
+    }
+
+    std::vector<double> ret_eigen;
+    ASSERT_EQ(true, MPCUtils::interp1d(idx, value_eigen, ref, ret_eigen));
+    for (unsigned int i = 0; i < ref.size(); ++i) {
+        ASSERT_DOUBLE_EQ(ret[i], ret_eigen[i]) << "i = " << i;
+    }
+
+    std::vector<double> ref_unsorted = {0.0, 1.0, 0.5};
+    ASSERT_EQ(false, MPCUtils::interp1d(idx, value, ref_unsorted, ret));
+
+    std::vector<double> idx_bad = {0.0, 1.0, 0.0, 3.0};
+    std::vector<double> value_bad = {-2.0, 0.0, 2.0, 4.0};
+    ASSERT_EQ(false, MPCUtils::interp1d(idx_bad, value_bad, ref, ret));
+}
+
 
 TEST(TestSuite, TestCalcTrajectoryYawFromXY) {
 
@@ -210,6 +245,48 @@ TEST(TestSuite, TestCalcNearestPose){
 
 }
 
+TEST(TestSuite, TestCalcNearestPoseInterpWithWindow){
+
+    MPCTrajectory traj;
+    for (int i = 0; i < 1000; ++i) {
+        /*              x         y    z   yaw  vx   k   time */
+        traj.push_back(0.1 * i, 0.0, 0.0, 0.0, 1.0, 0.0, 0.1 * i);
+    }
+
+    geometry_msgs::Pose self_pose;
+    geometry_msgs::Pose nearest_pose, nearest_pose_window;
+    unsigned int nearest_index, nearest_index_window;
+    double min_dist_error, nearest_yaw_error, nearest_time;
+    double min_dist_error_window, nearest_yaw_error_window, nearest_time_window;
+    self_pose.orientation = amathutils::getQuaternionFromYaw(0.0);
+
+    /* moving forward from the previous nearest point */
+    int prev_nearest_index = -1;
+    for (double x = 0.0; x < 90.0; x += 0.73) {
+        self_pose.position.x = x;
+        self_pose.position.y = 0.2;
+        MPCUtils::calcNearestPoseInterp(traj, self_pose, nearest_pose, nearest_index, min_dist_error, nearest_yaw_error, nearest_time);
+        ASSERT_EQ(true, MPCUtils::calcNearestPoseInterp(traj, self_pose, prev_nearest_index, 10, nearest_pose_window, nearest_index_window,
+                                                        min_dist_error_window, nearest_yaw_error_window, nearest_time_window));
+        ASSERT_EQ(nearest_index, nearest_index_window) << "x = " << x;
+        ASSERT_DOUBLE_EQ(min_dist_error, min_dist_error_window) << "x = " << x;
+        ASSERT_DOUBLE_EQ(nearest_time, nearest_time_window) << "x = " << x;
+        prev_nearest_index = nearest_index_window;
+    }
+
+    /* self pose jumped out of the search window */
+    self_pose.position.x = 10.0;
+    MPCUtils::calcNearestPoseInterp(traj, self_pose, prev_nearest_index, 10, nearest_pose_window, nearest_index_window,
+                                    min_dist_error_window, nearest_yaw_error_window, nearest_time_window);
+    ASSERT_EQ(100, nearest_index_window);
+
+    /* previous index out of the trajectory */
+    self_pose.position.x = 50.0;
+    MPCUtils::calcNearestPoseInterp(traj, self_pose, 5000, 10, nearest_pose_window, nearest_index_window,
+                                    min_dist_error_window, nearest_yaw_error_window, nearest_time_window);
+    ASSERT_EQ(500, nearest_index_window);
+}
+
 TEST(TestSuite, TestInterp1dMPCTraj){
 
     MPCTrajectory traj, traj_result;
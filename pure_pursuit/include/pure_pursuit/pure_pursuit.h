@@ -51,9 +51,11 @@ public:
   {
     current_linear_velocity_ = cur_vel;
   }
-  void setCurrentWaypoints(const std::vector<autoware_msgs::Waypoint>& wps)
+  void setCurrentWaypoints(const autoware_msgs::LaneConstPtr& lane)
   {
-    current_waypoints_ = wps;
+    current_lane_ = lane;
+    closest_waypoint_number_ = -1;
+    next_waypoint_number_ = -1;
   }
   void setCurrentPose(const geometry_msgs::PoseStampedConstPtr& msg)
   {
@@ -67,7 +69,8 @@ public:
   // for debug on ROS
   geometry_msgs::Point getPoseOfNextWaypoint() const
   {
-    return current_waypoints_.at(next_waypoint_number_).pose.pose.position;
+    return current_lane_->waypoints.at(next_waypoint_number_)
+      .pose.pose.position;
   }
   geometry_msgs::Point getPoseOfNextTarget() const
   {
@@ -77,9 +80,9 @@ public:
   {
     return current_pose_;
   }
-  std::vector<autoware_msgs::Waypoint> getCurrentWaypoints() const
+  const std::vector<autoware_msgs::Waypoint>& getCurrentWaypoints() const
   {
-    return current_waypoints_;
+    return current_lane_->waypoints;
   }
   double getLookaheadDistance() const
   {
@@ -96,21 +99,26 @@ private:
   // constant
   const double RADIUS_MAX_;
   const double KAPPA_MIN_;
+  const int CLOSEST_SEARCH_WINDOW_;
+  const double LOOKAHEAD_SEARCH_RATIO_;
 
   // variables
   bool is_linear_interpolation_;
   int next_waypoint_number_;
+  int closest_waypoint_number_;
   geometry_msgs::Point next_target_position_;
   double lookahead_distance_;
   double minimum_lookahead_distance_;
   geometry_msgs::Pose current_pose_;
   double current_linear_velocity_;
-  std::vector<autoware_msgs::Waypoint> current_waypoints_;
+  autoware_msgs::LaneConstPtr current_lane_;
 
   // functions
   double calcCurvature(geometry_msgs::Point target) const;
   bool interpolateNextTarget(
     int next_waypoint, geometry_msgs::Point* next_target) const;
+  int findClosestWaypoint(int begin, int end) const;
+  void updateClosestWaypoint();
   void getNextWaypoint();
 };
 }  // namespace waypoint_follower
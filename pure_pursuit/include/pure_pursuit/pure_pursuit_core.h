@@ -80,6 +80,9 @@ private:
 
   // control loop update rate
   double update_rate_;
+  // maximum rate of marker publication for Rviz
+  double visualization_rate_;
+  ros::Time last_visualization_time_;
 
   // variables
   bool is_linear_interpolation_, publishes_for_steering_robot_,
@@ -112,6 +115,7 @@ private:
     const bool& can_get_curvature, const double& kappa) const;
   void publishControlCommandStamped(
     const bool& can_get_curvature, const double& kappa) const;
+  void publishVisualization() const;
   void publishDeviationCurrentPosition(
     const geometry_msgs::Point& point,
     const std::vector<autoware_msgs::Waypoint>& waypoints) const;
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <limits>
+
 #include <pure_pursuit/pure_pursuit.h>
 
 namespace waypoint_follower
@@ -22,11 +25,15 @@ namespace waypoint_follower
 PurePursuit::PurePursuit()
   : RADIUS_MAX_(9e10)
   , KAPPA_MIN_(1 / RADIUS_MAX_)
+  , CLOSEST_SEARCH_WINDOW_(20)
+  , LOOKAHEAD_SEARCH_RATIO_(3.0)
   , is_linear_interpolation_(false)
   , next_waypoint_number_(-1)
+  , closest_waypoint_number_(-1)
   , lookahead_distance_(0)
   , minimum_lookahead_distance_(6)
   , current_linear_velocity_(0)
+  , current_lane_(boost::make_shared<autoware_msgs::Lane>())
 {
 }
 
@@ -66,18 +73,20 @@ bool PurePursuit::interpolateNextTarget(
 {
   constexpr double ERROR = pow(10, -5);  // 0.00001
 
-  int path_size = static_cast<int>(current_waypoints_.size());
+  const std::vector<autoware_msgs::Waypoint>& waypoints =
+    current_lane_->waypoints;
+  int path_size = static_cast<int>(waypoints.size());
   if (next_waypoint == path_size - 1)
   {
-    *next_target = current_waypoints_.at(next_waypoint).pose.pose.position;
+    *next_target = waypoints.at(next_waypoint).pose.pose.position;
     return true;
   }
   double search_radius = lookahead_distance_;
   geometry_msgs::Point zero_p;
   geometry_msgs::Point end =
-    current_waypoints_.at(next_waypoint).pose.pose.position;
+    waypoints.at(next_waypoint).pose.pose.position;
   geometry_msgs::Point start =
-    current_waypoints_.at(next_waypoint - 1).pose.pose.position;
+    waypoints.at(next_waypoint - 1).pose.pose.position;
 
   // let the linear equation be "ax + by + c = 0"
   // if there are two points (x1,y1) , (x2,y2),
@@ -196,9 +205,54 @@ bool PurePursuit::interpolateNextTarget(
   }
 }
 
+int PurePursuit::findClosestWaypoint(int begin, int end) const
+{
+  const std::vector<autoware_msgs::Waypoint>& waypoints =
+    current_lane_->waypoints;
+  int closest = -1;
+  double min_distance = std::numeric_limits<double>::max();
+  for (int i = begin; i < end; i++)
+  {
+    double distance = getPlaneDistance(
+      waypoints.at(i).pose.pose.position, current_pose_.position);
+    if (distance < min_distance)
+    {
+      min_distance = distance;
+      closest = i;
+    }
+  }
+  return closest;
+}
+
+void PurePursuit::updateClosestWaypoint()
+{
+  int path_size = static_cast<int>(current_lane_->waypoints.size());
+
+  // search around the closest waypoint of the previous cycle
+  int begin = 0;
+  int end = path_size;
+  if (closest_waypoint_number_ >= 0 && closest_waypoint_number_ < path_size)
+  {
+    begin = std::max(closest_waypoint_number_ - CLOSEST_SEARCH_WINDOW_, 0);
+    end = std::min(closest_waypoint_number_ + CLOSEST_SEARCH_WINDOW_ + 1,
+      path_size);
+  }
+  closest_waypoint_number_ = findClosestWaypoint(begin, end);
+
+  // the closest one on the window edge means the pose jumped,
+  // so search all waypoints again.
+  if ((closest_waypoint_number_ == begin && begin > 0) ||
+    (closest_waypoint_number_ == end - 1 && end < path_size))
+  {
+    closest_waypoint_number_ = findClosestWaypoint(0, path_size);
+  }
+}
+
 void PurePursuit::getNextWaypoint()
 {
-  int path_size = static_cast<int>(current_waypoints_.size());
+  const std::vector<autoware_msgs::Waypoint>& waypoints =
+    current_lane_->waypoints;
+  int path_size = static_cast<int>(waypoints.size());
 
   // if waypoints are not given, do nothing.
   if (path_size == 0)
@@ -207,30 +261,52 @@ void PurePursuit::getNextWaypoint()
     return;
   }
 
-  // look for the next waypoint.
-  for (int i = 0; i < path_size; i++)
+  // resume from the next waypoint of the previous cycle,
+  // going back while the lookahead circle has shrunk behind it.
+  updateClosestWaypoint();
+  int i = closest_waypoint_number_;
+  if (next_waypoint_number_ > i && next_waypoint_number_ < path_size)
   {
-    // if search waypoint is the last
-    if (i == (path_size - 1))
+    i = next_waypoint_number_;
+    while (i > closest_waypoint_number_ && getPlaneDistance(
+      waypoints.at(i - 1).pose.pose.position, current_pose_.position)
+      > lookahead_distance_)
     {
-      ROS_INFO("search waypoint is the last");
-      next_waypoint_number_ = i;
-      return;
+      i--;
     }
+  }
 
+  // look for the first waypoint out of the lookahead circle,
+  // within a bounded length along the path.
+  const double max_search_length =
+    LOOKAHEAD_SEARCH_RATIO_ * lookahead_distance_;
+  double search_length = 0.0;
+  while (i < path_size - 1)
+  {
     // if there exists an effective waypoint
     if (getPlaneDistance(
-      current_waypoints_.at(i).pose.pose.position, current_pose_.position)
+      waypoints.at(i).pose.pose.position, current_pose_.position)
       > lookahead_distance_)
     {
-      next_waypoint_number_ = i;
-      return;
+      break;
+    }
+
+    search_length += getPlaneDistance(
+      waypoints.at(i).pose.pose.position,
+      waypoints.at(i + 1).pose.pose.position);
+    i++;
+    if (search_length > max_search_length)
+    {
+      break;
     }
   }
 
-  // if this program reaches here , it means we lost the waypoint!
-  next_waypoint_number_ = -1;
-  return;
+  // if search waypoint is the last
+  if (i == path_size - 1)
+  {
+    ROS_INFO("search waypoint is the last");
+  }
+  next_waypoint_number_ = i;
 }
 
 bool PurePursuit::canGetCurvature(double* output_kappa)
@@ -242,12 +318,16 @@ bool PurePursuit::canGetCurvature(double* output_kappa)
     ROS_INFO("lost next waypoint");
     return false;
   }
-  // check whether curvature is valid or not
+  const std::vector<autoware_msgs::Waypoint>& waypoints =
+    current_lane_->waypoints;
+  // check whether curvature is valid or not,
+  // usually the next waypoint is already out of the minimum lookahead circle
   bool is_valid_curve = false;
-  for (const auto& el : current_waypoints_)
+  for (int i = closest_waypoint_number_;
+    i < static_cast<int>(waypoints.size()); i++)
   {
-    if (getPlaneDistance(el.pose.pose.position, current_pose_.position)
-      > minimum_lookahead_distance_)
+    if (getPlaneDistance(waypoints.at(i).pose.pose.position,
+      current_pose_.position) > minimum_lookahead_distance_)
     {
       is_valid_curve = true;
       break;
@@ -257,12 +337,16 @@ bool PurePursuit::canGetCurvature(double* output_kappa)
   {
     return false;
   }
-  // if is_linear_interpolation_ is false or next waypoint is first or last
+  const geometry_msgs::Point& next_waypoint_position =
+    waypoints.at(next_waypoint_number_).pose.pose.position;
+  // if is_linear_interpolation_ is false or next waypoint is first or last,
+  // or search stopped inside the lookahead circle
   if (!is_linear_interpolation_ || next_waypoint_number_ == 0 ||
-    next_waypoint_number_ == (static_cast<int>(current_waypoints_.size() - 1)))
+    next_waypoint_number_ == (static_cast<int>(waypoints.size() - 1)) ||
+    getPlaneDistance(next_waypoint_position, current_pose_.position)
+    <= lookahead_distance_)
   {
-    next_target_position_ =
-      current_waypoints_.at(next_waypoint_number_).pose.pose.position;
+    next_target_position_ = next_waypoint_position;
     *output_kappa = calcCurvature(next_target_position_);
     return true;
   }
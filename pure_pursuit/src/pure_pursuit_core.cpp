@@ -24,6 +24,7 @@ PurePursuitNode::PurePursuitNode()
   : private_nh_("~")
   , pp_()
   , update_rate_(30.0)
+  , visualization_rate_(10.0)
   , is_waypoint_set_(false)
   , is_pose_set_(false)
   , is_velocity_set_(false)
@@ -64,6 +65,13 @@ void PurePursuitNode::initForROS()
   private_nh_.param(
     "minimum_lookahead_distance", minimum_lookahead_distance_, 6.0);
   private_nh_.param("update_rate", update_rate_, 30.0);
+  private_nh_.param("visualization_rate", visualization_rate_, 10.0);
+  if (!(visualization_rate_ > 0.0))
+  {
+    ROS_WARN("visualization_rate must be positive, got %f, use 10.0",
+      visualization_rate_);
+    visualization_rate_ = 10.0;
+  }
   nh_.param("vehicle_info/wheel_base", wheel_base_, 2.7);
 
   // setup subscriber
@@ -118,26 +126,25 @@ void PurePursuitNode::run()
     health_checker_ptr_->NODE_ACTIVATE();
     health_checker_ptr_->CHECK_RATE("topic_rate_vehicle_cmd_slow", 8, 5, 1,
       "topic vehicle_cmd publish rate slow.");
-    // for visualization with Rviz
-    pub11_.publish(displayNextWaypoint(pp_.getPoseOfNextWaypoint()));
-    pub13_.publish(displaySearchRadius(
-      pp_.getCurrentPose().position, pp_.getLookaheadDistance()));
-    pub12_.publish(displayNextTarget(pp_.getPoseOfNextTarget()));
-    pub15_.publish(displayTrajectoryCircle(
-        waypoint_follower::generateTrajectoryCircle(
-          pp_.getPoseOfNextTarget(), pp_.getCurrentPose())));
-    if (add_virtual_end_waypoints_)
+    // for visualization with Rviz, at a lower rate than control
+    const ros::Time now = ros::Time::now();
+    if ((now - last_visualization_time_).toSec() >= 1.0 / visualization_rate_)
     {
-      pub18_.publish(
-        displayExpandWaypoints(pp_.getCurrentWaypoints(), expand_size_));
+      publishVisualization();
+      last_visualization_time_ = now;
+    }
+    if (pub16_.getNumSubscribers() > 0)
+    {
+      std_msgs::Float32 angular_gravity_msg;
+      angular_gravity_msg.data =
+        computeAngularGravity(computeCommandVelocity(), kappa);
+      pub16_.publish(angular_gravity_msg);
+    }
+    if (pub17_.getNumSubscribers() > 0)
+    {
+      publishDeviationCurrentPosition(
+        pp_.getCurrentPose().position, pp_.getCurrentWaypoints());
     }
-    std_msgs::Float32 angular_gravity_msg;
-    angular_gravity_msg.data =
-      computeAngularGravity(computeCommandVelocity(), kappa);
-    pub16_.publish(angular_gravity_msg);
-
-    publishDeviationCurrentPosition(
-      pp_.getCurrentPose().position, pp_.getCurrentWaypoints());
 
     is_pose_set_ = false;
     is_velocity_set_ = false;
@@ -174,6 +181,35 @@ void PurePursuitNode::publishControlCommandStamped(
   pub2_.publish(ccs);
 }
 
+void PurePursuitNode::publishVisualization() const
+{
+  // markers are built only for subscribed topics
+  if (pub11_.getNumSubscribers() > 0)
+  {
+    pub11_.publish(displayNextWaypoint(pp_.getPoseOfNextWaypoint()));
+  }
+  if (pub13_.getNumSubscribers() > 0)
+  {
+    pub13_.publish(displaySearchRadius(
+      pp_.getCurrentPose().position, pp_.getLookaheadDistance()));
+  }
+  if (pub12_.getNumSubscribers() > 0)
+  {
+    pub12_.publish(displayNextTarget(pp_.getPoseOfNextTarget()));
+  }
+  if (pub15_.getNumSubscribers() > 0)
+  {
+    pub15_.publish(displayTrajectoryCircle(
+        waypoint_follower::generateTrajectoryCircle(
+          pp_.getPoseOfNextTarget(), pp_.getCurrentPose())));
+  }
+  if (add_virtual_end_waypoints_ && pub18_.getNumSubscribers() > 0)
+  {
+    pub18_.publish(
+      displayExpandWaypoints(pp_.getCurrentWaypoints(), expand_size_));
+  }
+}
+
 double PurePursuitNode::computeLookaheadDistance() const
 {
   if (velocity_source_ == enumToInteger(Mode::dialog))
@@ -292,16 +328,18 @@ void PurePursuitNode::callbackFromWayPoints(
   {
     const LaneDirection solved_dir = getLaneDirection(*msg);
     direction_ = (solved_dir != LaneDirection::Error) ? solved_dir : direction_;
-    autoware_msgs::Lane expanded_lane(*msg);
-    expand_size_ = -expanded_lane.waypoints.size();
-    connectVirtualLastWaypoints(&expanded_lane, direction_);
-    expand_size_ += expanded_lane.waypoints.size();
+    autoware_msgs::LanePtr expanded_lane =
+      boost::make_shared<autoware_msgs::Lane>(*msg);
+    expand_size_ = -expanded_lane->waypoints.size();
+    connectVirtualLastWaypoints(expanded_lane.get(), direction_);
+    expand_size_ += expanded_lane->waypoints.size();
 
-    pp_.setCurrentWaypoints(expanded_lane.waypoints);
+    pp_.setCurrentWaypoints(expanded_lane);
   }
   else
   {
-    pp_.setCurrentWaypoints(msg->waypoints);
+    // share the received message, not to copy waypoints
+    pp_.setCurrentWaypoints(msg);
   }
   is_waypoint_set_ = true;
 }
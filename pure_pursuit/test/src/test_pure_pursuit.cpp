@@ -111,6 +111,49 @@ TEST_F(PurePursuitNodeTestSuite, inputNormalLane)
   ASSERT_LT(original_lane.waypoints.size(), new_lane.waypoints.size())
     << "Fail to expand waypoints";
 }
+
+// The next waypoint is the first one out of the lookahead circle
+// ahead of the vehicle, even on a long route starting behind it.
+TEST_F(PurePursuitNodeTestSuite, nextWaypointOnLongLane)
+{
+  autoware_msgs::LanePtr lane = boost::make_shared<autoware_msgs::Lane>();
+  lane->waypoints.resize(1000, autoware_msgs::Waypoint());
+  for (int i = 0; i < 1000; i++)
+  {
+    lane->waypoints[i].pose.pose.position.x = i;
+    lane->waypoints[i].pose.pose.orientation =
+      tf::createQuaternionMsgFromYaw(0.0);
+  }
+  PurePursuit pp;
+  pp.setCurrentWaypoints(lane);
+  pp.setLookaheadDistance(5.5);
+  pp.setMinimumLookaheadDistance(3.0);
+
+  geometry_msgs::PoseStampedPtr pose =
+    boost::make_shared<geometry_msgs::PoseStamped>();
+  pose->pose.orientation = tf::createQuaternionMsgFromYaw(0.0);
+  double kappa = 0.0;
+  for (double x = 100.0; x < 200.0; x += 0.7)
+  {
+    pose->pose.position.x = x;
+    pp.setCurrentPose(pose);
+    ASSERT_TRUE(pp.canGetCurvature(&kappa));
+    ASSERT_DOUBLE_EQ(std::floor(x + 5.5) + 1.0, pp.getPoseOfNextWaypoint().x)
+      << "x = " << x;
+  }
+
+  // lookahead distance gets shorter
+  pp.setLookaheadDistance(3.5);
+  ASSERT_TRUE(pp.canGetCurvature(&kappa));
+  ASSERT_DOUBLE_EQ(std::floor(pose->pose.position.x + 3.5) + 1.0,
+    pp.getPoseOfNextWaypoint().x);
+
+  // vehicle jumps backward
+  pose->pose.position.x = 10.2;
+  pp.setCurrentPose(pose);
+  ASSERT_TRUE(pp.canGetCurvature(&kappa));
+  ASSERT_DOUBLE_EQ(14.0, pp.getPoseOfNextWaypoint().x);
+}
 }  // namespace waypoint_follower
 
 int main(int argc, char** argv)
@@ -2,12 +2,16 @@
 #define _VELOCITY_SET_H
 
 #include <math.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <map>
 #include <unordered_map>
 #include <vector>
 
 #include <geometry_msgs/Point.h>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
 #include <ros/ros.h>
 #include <vector_map/vector_map.h>
 
@@ -179,6 +183,40 @@ public:
   }
 };
 
+//////////////////////////////////////
+// 2D uniform grid of obstacle points
+//////////////////////////////////////
+class PointsGrid
+{
+private:
+  // upper bound of width_ * height_
+  static constexpr double MAX_CELL_NUM = 1 << 22;
+
+  double cell_size_;
+  double min_x_;
+  double min_y_;
+  int width_;
+  int height_;
+
+  // points in cell c are [cell_start_[c], cell_start_[c + 1]) of the arrays below
+  std::vector<int> cell_start_;
+  std::vector<int> point_indices_;  // index in the original pointcloud
+  std::vector<float> xs_;
+  std::vector<float> ys_;
+
+public:
+  void build(const pcl::PointCloud<pcl::PointXYZ> &points, const double cell_size);
+  void clear();
+
+  // indices of points with min_range < 2D distance from (x, y) < max_range, in ascending order
+  void radiusSearch(const double x, const double y, const double min_range, const double max_range,
+                    std::vector<int> *indices) const;
+
+  PointsGrid() : cell_size_(1.0), min_x_(0), min_y_(0), width_(0), height_(0)
+  {
+  }
+};
+
 inline double calcSquareOfLength(const geometry_msgs::Point &p1, const geometry_msgs::Point &p2)
 {
   return (p1.x - p2.x) * (p1.x - p2.x) + (p1.y - p2.y) * (p1.y - p2.y) + (p1.z - p2.z) * (p1.z - p2.z);
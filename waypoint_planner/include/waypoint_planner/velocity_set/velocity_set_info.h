@@ -27,6 +27,8 @@
 #include <autoware_health_checker/health_checker/health_checker.h>
 #include <memory>
 
+#include <waypoint_planner/velocity_set/libvelocity_set.h>
+
 class VelocitySetInfo
 {
  private:
@@ -48,6 +50,7 @@ class VelocitySetInfo
   double remove_points_upto_;
 
   pcl::PointCloud<pcl::PointXYZ> points_;
+  PointsGrid points_grid_;  // points_ indexed for range queries
   geometry_msgs::PoseStamped localizer_pose_;  // pose of sensor
   geometry_msgs::PoseStamped control_pose_;    // pose of base_link
   bool set_pose_;
@@ -128,11 +131,16 @@ class VelocitySetInfo
     return temporal_waypoints_size_;
   }
 
-  pcl::PointCloud<pcl::PointXYZ> getPoints() const
+  const pcl::PointCloud<pcl::PointXYZ>& getPoints() const
   {
     return points_;
   }
 
+  const PointsGrid& getPointsGrid() const
+  {
+    return points_grid_;
+  }
+
   geometry_msgs::PoseStamped getControlPose() const
   {
     return control_pose_;
@@ -17,6 +17,8 @@
 #ifndef VELOCITY_SET_PATH_H
 #define VELOCITY_SET_PATH_H
 
+#include <vector>
+
 #include <autoware_msgs/Lane.h>
 #include <libwaypoint_follower/libwaypoint_follower.h>
 
@@ -26,6 +28,7 @@ class VelocitySetPath
   autoware_msgs::Lane original_waypoints_;
   autoware_msgs::Lane updated_waypoints_;
   autoware_msgs::Lane temporal_waypoints_;
+  std::vector<double> arc_length_;  // distance from the first original waypoint to each waypoint
   bool set_path_{false};
   double current_vel_{0.0};
 
@@ -34,6 +37,7 @@ class VelocitySetPath
   double decelerate_vel_min_; // m/s
 
   bool checkWaypoint(int num) const;
+  void updateArcLength();
 
  public:
   VelocitySetPath();
@@ -230,6 +230,9 @@ bool AstarAvoid::planAvoidWaypoints(int& end_of_avoid_index)
   bool found_path = false;
   int closest_waypoint_index = getLocalClosestWaypoint(avoid_waypoints_, current_pose_global_.pose, closest_search_size_);
 
+  // update costmap for A* search, shared by every goal candidate
+  astar_.initialize(costmap_);
+
   // update goal pose incrementally and execute A* search
   for (int i = search_waypoints_delta_; i < static_cast<int>(search_waypoints_size_); i += search_waypoints_delta_)
   {
@@ -249,9 +252,6 @@ bool AstarAvoid::planAvoidWaypoints(int& end_of_avoid_index)
     goal_pose_local_.pose = transformPose(goal_pose_global_.pose,
                                           getTransform(costmap_.header.frame_id, goal_pose_global_.header.frame_id));
 
-    // initialize costmap for A* search
-    astar_.initialize(costmap_);
-
     // execute astar search
     found_path = astar_.makePlan(current_pose_local_.pose, goal_pose_local_.pose);
 
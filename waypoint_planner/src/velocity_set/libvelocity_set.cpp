@@ -333,3 +333,117 @@ geometry_msgs::Point ObstaclePoints::getObstaclePoint(const EControl &kind) cons
     return point;
   }
 }
+
+void PointsGrid::build(const pcl::PointCloud<pcl::PointXYZ> &points, const double cell_size)
+{
+  clear();
+
+  // points with NaN or infinite x/y are never in range, skip them
+  bool found = false;
+  double max_x = 0;
+  double max_y = 0;
+  for (const auto &p : points)
+  {
+    if (!std::isfinite(p.x) || !std::isfinite(p.y))
+      continue;
+    if (!found)
+    {
+      min_x_ = max_x = p.x;
+      min_y_ = max_y = p.y;
+      found = true;
+      continue;
+    }
+    min_x_ = std::min(min_x_, static_cast<double>(p.x));
+    min_y_ = std::min(min_y_, static_cast<double>(p.y));
+    max_x = std::max(max_x, static_cast<double>(p.x));
+    max_y = std::max(max_y, static_cast<double>(p.y));
+  }
+  if (!found)
+    return;
+
+  // enlarge cells if far outliers would make too many of them
+  cell_size_ = cell_size;
+  while ((std::floor((max_x - min_x_) / cell_size_) + 1) * (std::floor((max_y - min_y_) / cell_size_) + 1) >
+         MAX_CELL_NUM)
+    cell_size_ *= 2;
+  width_ = static_cast<int>((max_x - min_x_) / cell_size_) + 1;
+  height_ = static_cast<int>((max_y - min_y_) / cell_size_) + 1;
+
+  // counting sort of points by cell
+  std::vector<int> cells(points.size(), -1);
+  cell_start_.assign(static_cast<size_t>(width_) * height_ + 1, 0);
+  for (size_t i = 0; i < points.size(); i++)
+  {
+    if (!std::isfinite(points[i].x) || !std::isfinite(points[i].y))
+      continue;
+    int ix = std::min(static_cast<int>((points[i].x - min_x_) / cell_size_), width_ - 1);
+    int iy = std::min(static_cast<int>((points[i].y - min_y_) / cell_size_), height_ - 1);
+    cells[i] = iy * width_ + ix;
+    cell_start_[cells[i] + 1]++;
+  }
+  for (size_t c = 1; c < cell_start_.size(); c++)
+    cell_start_[c] += cell_start_[c - 1];
+
+  point_indices_.resize(cell_start_.back());
+  xs_.resize(cell_start_.back());
+  ys_.resize(cell_start_.back());
+  std::vector<int> next(cell_start_.begin(), cell_start_.end() - 1);
+  for (size_t i = 0; i < points.size(); i++)
+  {
+    if (cells[i] < 0)
+      continue;
+    int k = next[cells[i]]++;
+    point_indices_[k] = i;
+    xs_[k] = points[i].x;
+    ys_[k] = points[i].y;
+  }
+}
+
+void PointsGrid::clear()
+{
+  width_ = 0;
+  height_ = 0;
+  cell_start_.clear();
+  point_indices_.clear();
+  xs_.clear();
+  ys_.clear();
+}
+
+void PointsGrid::radiusSearch(const double x, const double y, const double min_range, const double max_range,
+                              std::vector<int> *indices) const
+{
+  indices->clear();
+  if (point_indices_.empty() || !std::isfinite(x) || !std::isfinite(y))
+    return;
+
+  // cells overlapping the bounding box of the circle
+  double min_ix = std::floor((x - max_range - min_x_) / cell_size_);
+  double max_ix = std::floor((x + max_range - min_x_) / cell_size_);
+  double min_iy = std::floor((y - max_range - min_y_) / cell_size_);
+  double max_iy = std::floor((y + max_range - min_y_) / cell_size_);
+  if (max_ix < 0 || max_iy < 0 || min_ix >= width_ || min_iy >= height_)
+    return;
+
+  int begin_x = static_cast<int>(std::max(min_ix, 0.0));
+  int end_x = static_cast<int>(std::min(max_ix, width_ - 1.0));
+  int begin_y = static_cast<int>(std::max(min_iy, 0.0));
+  int end_y = static_cast<int>(std::min(max_iy, height_ - 1.0));
+  for (int iy = begin_y; iy <= end_y; iy++)
+  {
+    for (int ix = begin_x; ix <= end_x; ix++)
+    {
+      int c = iy * width_ + ix;
+      for (int k = cell_start_[c]; k < cell_start_[c + 1]; k++)
+      {
+        double dx = xs_[k] - x;
+        double dy = ys_[k] - y;
+        double dt = std::sqrt(dx * dx + dy * dy);
+        if (dt > min_range && dt < max_range)
+          indices->push_back(point_indices_[k]);
+      }
+    }
+  }
+
+  // same order as the pointcloud
+  std::sort(indices->begin(), indices->end());
+}
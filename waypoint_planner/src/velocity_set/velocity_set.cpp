@@ -252,14 +252,15 @@ EControl crossWalkDetection(const pcl::PointCloud<pcl::PointXYZ>& pcl_points, co
   return EControl::KEEP;  // find no obstacles
 }
 
-int detectStopObstacle(const pcl::PointCloud<pcl::PointXYZ>& pcl_points, const int closest_waypoint,
-                       const autoware_msgs::Lane& lane, const CrossWalk& crosswalk, double stop_range,
-                       double points_threshold, const geometry_msgs::PoseStamped& localizer_pose,
+int detectStopObstacle(const pcl::PointCloud<pcl::PointXYZ>& pcl_points, const PointsGrid& points_grid,
+                       const int closest_waypoint, const autoware_msgs::Lane& lane, const CrossWalk& crosswalk,
+                       double stop_range, double points_threshold, const geometry_msgs::PoseStamped& localizer_pose,
                        ObstaclePoints* obstacle_points, EObstacleType* obstacle_type,
                        const int wpidx_detection_result_by_other_nodes)
 {
   int stop_obstacle_waypoint = -1;
   *obstacle_type = EObstacleType::NONE;
+  std::vector<int> point_indices;
   // start search from the closest waypoint
   for (int i = closest_waypoint; i < closest_waypoint + STOP_SEARCH_DISTANCE && i < static_cast<int>(lane.waypoints.size()); i++)
   {
@@ -292,22 +293,17 @@ int detectStopObstacle(const pcl::PointCloud<pcl::PointXYZ>& pcl_points, const i
     tf::Vector3 tf_waypoint = point2vector(waypoint);
     tf_waypoint.setZ(0);
 
-    int stop_point_count = 0;
-    for (const auto& p : pcl_points)
+    // points within stop range around the waypoint
+    points_grid.radiusSearch(tf_waypoint.x(), tf_waypoint.y(), -1.0, stop_range, &point_indices);
+    int stop_point_count = point_indices.size();
+    for (const int index : point_indices)
     {
-      tf::Vector3 point_vector(p.x, p.y, 0);
-
-      // 2D distance between waypoint and points (obstacle)
-      double dt = tf::tfDistance(point_vector, tf_waypoint);
-      if (dt < stop_range)
-      {
-        stop_point_count++;
-        geometry_msgs::Point point_temp;
-        point_temp.x = p.x;
-        point_temp.y = p.y;
-        point_temp.z = p.z;
-        obstacle_points->setStopPoint(calcAbsoluteCoordinate(point_temp, localizer_pose.pose));
-      }
+      const auto& p = pcl_points[index];
+      geometry_msgs::Point point_temp;
+      point_temp.x = p.x;
+      point_temp.y = p.y;
+      point_temp.z = p.z;
+      obstacle_points->setStopPoint(calcAbsoluteCoordinate(point_temp, localizer_pose.pose));
     }
 
     // there is an obstacle if the number of points exceeded the threshold
@@ -324,12 +320,13 @@ int detectStopObstacle(const pcl::PointCloud<pcl::PointXYZ>& pcl_points, const i
   return stop_obstacle_waypoint;
 }
 
-int detectDecelerateObstacle(const pcl::PointCloud<pcl::PointXYZ>& pcl_points, const int closest_waypoint,
-                             const autoware_msgs::Lane& lane, const double stop_range, const double deceleration_range,
-                             const double points_threshold, const geometry_msgs::PoseStamped& localizer_pose,
-                             ObstaclePoints* obstacle_points)
+int detectDecelerateObstacle(const pcl::PointCloud<pcl::PointXYZ>& pcl_points, const PointsGrid& points_grid,
+                             const int closest_waypoint, const autoware_msgs::Lane& lane, const double stop_range,
+                             const double deceleration_range, const double points_threshold,
+                             const geometry_msgs::PoseStamped& localizer_pose, ObstaclePoints* obstacle_points)
 {
   int decelerate_obstacle_waypoint = -1;
+  std::vector<int> point_indices;
   // start search from the closest waypoint
   for (int i = closest_waypoint; i < closest_waypoint + DECELERATION_SEARCH_DISTANCE && i < static_cast<int>(lane.waypoints.size()); i++)
   {
@@ -338,22 +335,18 @@ int detectDecelerateObstacle(const pcl::PointCloud<pcl::PointXYZ>& pcl_points, c
     tf::Vector3 tf_waypoint = point2vector(waypoint);
     tf_waypoint.setZ(0);
 
-    int decelerate_point_count = 0;
-    for (const auto& p : pcl_points)
+    // points within deceleration range around the waypoint
+    points_grid.radiusSearch(tf_waypoint.x(), tf_waypoint.y(), stop_range, stop_range + deceleration_range,
+                             &point_indices);
+    int decelerate_point_count = point_indices.size();
+    for (const int index : point_indices)
     {
-      tf::Vector3 point_vector(p.x, p.y, 0);
-
-      // 2D distance between waypoint and points (obstacle)
-      double dt = tf::tfDistance(point_vector, tf_waypoint);
-      if (dt > stop_range && dt < stop_range + deceleration_range)
-      {
-        decelerate_point_count++;
-        geometry_msgs::Point point_temp;
-        point_temp.x = p.x;
-        point_temp.y = p.y;
-        point_temp.z = p.z;
-        obstacle_points->setDeceleratePoint(calcAbsoluteCoordinate(point_temp, localizer_pose.pose));
-      }
+      const auto& p = pcl_points[index];
+      geometry_msgs::Point point_temp;
+      point_temp.x = p.x;
+      point_temp.y = p.y;
+      point_temp.z = p.z;
+      obstacle_points->setDeceleratePoint(calcAbsoluteCoordinate(point_temp, localizer_pose.pose));
     }
 
     // there is an obstacle if the number of points exceeded the threshold
@@ -382,8 +375,8 @@ EControl pointsDetection(const pcl::PointCloud<pcl::PointXYZ>& pcl_points, const
 
   EObstacleType obstacle_type = EObstacleType::NONE;
   int stop_obstacle_waypoint =
-      detectStopObstacle(pcl_points, closest_waypoint, lane, crosswalk, vs_info.getStopRange(),
-                         vs_info.getPointsThreshold(), vs_info.getLocalizerPose(),
+      detectStopObstacle(pcl_points, vs_info.getPointsGrid(), closest_waypoint, lane, crosswalk,
+                         vs_info.getStopRange(), vs_info.getPointsThreshold(), vs_info.getLocalizerPose(),
                          obstacle_points, &obstacle_type, vs_info.getDetectionResultByOtherNodes());
 
   // skip searching deceleration range
@@ -401,8 +394,9 @@ EControl pointsDetection(const pcl::PointCloud<pcl::PointXYZ>& pcl_points, const
   }
 
   int decelerate_obstacle_waypoint =
-      detectDecelerateObstacle(pcl_points, closest_waypoint, lane, vs_info.getStopRange(), vs_info.getDecelerationRange(),
-                               vs_info.getPointsThreshold(), vs_info.getLocalizerPose(), obstacle_points);
+      detectDecelerateObstacle(pcl_points, vs_info.getPointsGrid(), closest_waypoint, lane, vs_info.getStopRange(),
+                               vs_info.getDecelerationRange(), vs_info.getPointsThreshold(),
+                               vs_info.getLocalizerPose(), obstacle_points);
 
   // stop obstacle was not found
   if (stop_obstacle_waypoint < 0)
@@ -437,7 +431,7 @@ EControl pointsDetection(const pcl::PointCloud<pcl::PointXYZ>& pcl_points, const
 }
 
 EControl obstacleDetection(int closest_waypoint, const autoware_msgs::Lane& lane, const CrossWalk& crosswalk,
-                           const VelocitySetInfo vs_info, const ros::Publisher& detection_range_pub,
+                           const VelocitySetInfo& vs_info, const ros::Publisher& detection_range_pub,
                            const ros::Publisher& obstacle_pub, int* obstacle_waypoint)
 {
   ObstaclePoints obstacle_points;
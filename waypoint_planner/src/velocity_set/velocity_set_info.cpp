@@ -57,6 +57,7 @@ VelocitySetInfo::VelocitySetInfo()
 void VelocitySetInfo::clearPoints()
 {
   points_.clear();
+  points_grid_.clear();
 }
 
 void VelocitySetInfo::configCallback(const autoware_config_msgs::ConfigVelocitySetConstPtr &config)
@@ -95,6 +96,9 @@ void VelocitySetInfo::pointsCallback(const sensor_msgs::PointCloud2ConstPtr &msg
 
     points_.push_back(v);
   }
+
+  // cells about as large as the search range around a waypoint
+  points_grid_.build(points_, std::max(stop_range_ + deceleration_range_, 1.0));
 }
 
 void VelocitySetInfo::detectionCallback(const std_msgs::Int32 &msg)
@@ -198,20 +198,24 @@ double VelocitySetPath::calcInterval(const int begin, const int end) const
     return 0.0;
   }
 
-  // Calculate the inteval of waypoints
-  double dist_sum = 0.0;
-  for (int i = begin; i < end; i++)
-  {
-    tf::Vector3 v1(original_waypoints_.waypoints[i].pose.pose.position.x,
-                   original_waypoints_.waypoints[i].pose.pose.position.y, 0);
+  return arc_length_[end] - arc_length_[begin];
+}
 
-    tf::Vector3 v2(original_waypoints_.waypoints[i + 1].pose.pose.position.x,
-                   original_waypoints_.waypoints[i + 1].pose.pose.position.y, 0);
+// accumulate the interval of original waypoints once, so that any interval is a subtraction
+void VelocitySetPath::updateArcLength()
+{
+  const auto& waypoints = original_waypoints_.waypoints;
+  arc_length_.resize(waypoints.size());
+  if (waypoints.empty())
+    return;
 
-    dist_sum += tf::tfDistance(v1, v2);
+  arc_length_[0] = 0.0;
+  for (size_t i = 1; i < waypoints.size(); i++)
+  {
+    tf::Vector3 v1(waypoints[i - 1].pose.pose.position.x, waypoints[i - 1].pose.pose.position.y, 0);
+    tf::Vector3 v2(waypoints[i].pose.pose.position.x, waypoints[i].pose.pose.position.y, 0);
+    arc_length_[i] = arc_length_[i - 1] + tf::tfDistance(v1, v2);
   }
-
-  return dist_sum;
 }
 
 void VelocitySetPath::resetFlag()
@@ -225,6 +229,7 @@ void VelocitySetPath::waypointsCallback(const autoware_msgs::LaneConstPtr& msg)
   original_waypoints_ = *msg;
   // temporary, edit waypoints velocity later
   updated_waypoints_ = *msg;
+  updateArcLength();
 
   set_path_ = true;
 }
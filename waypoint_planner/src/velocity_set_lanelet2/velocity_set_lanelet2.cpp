@@ -30,8 +30,13 @@
 #include <lanelet2_extension/utility/query.h>
 #include <lanelet2_extension/visualization/visualization.h>
 
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <algorithm>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <waypoint_planner/velocity_set/libvelocity_set.h>
@@ -44,7 +49,19 @@ constexpr double STOP_SEARCH_DISTANCE = 60;
 
 static lanelet::LaneletMapPtr g_lanelet_map;
 static bool g_loaded_lanelet_map;
-lanelet::ConstLanelets g_crosswalk_lanelets;
+
+// crosswalk lanelets indexed by their bounding box, built once when the map is loaded
+struct CrosswalkIndex
+{
+  using Point = boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian>;
+  using Box = boost::geometry::model::box<Point>;
+  using Value = std::pair<Box, size_t>;
+
+  lanelet::ConstLanelets lanelets;
+  std::vector<lanelet::BasicPolygon2d> polygons;  // 2D polygon in map frame for each lanelet
+  boost::geometry::index::rtree<Value, boost::geometry::index::rstar<16>> rtree;
+};
+static CrosswalkIndex g_crosswalk_index;
 
 // set color according to given obstacle
 void obstacleColorByKind(const EControl kind, std_msgs::ColorRGBA* color, const double alpha = 0.5)
@@ -117,8 +134,45 @@ void displayObstacle(const EControl& kind, const ObstaclePoints& obstacle_points
   obstacle_pub.publish(marker);
 }
 
+void buildCrosswalkIndex(const lanelet::ConstLanelets& lanelets, CrosswalkIndex* index)
+{
+  index->lanelets.clear();
+  index->polygons.clear();
+  index->rtree.clear();
+
+  std::vector<CrosswalkIndex::Value> boxes;
+  for (const auto& ll : lanelets)
+  {
+    if (!ll.hasAttribute(lanelet::AttributeName::Subtype) ||
+        ll.attribute(lanelet::AttributeName::Subtype).value() != lanelet::AttributeValueString::Crosswalk)
+    {
+      continue;
+    }
+
+    lanelet::BasicPolygon2d polygon = ll.polygon2d().basicPolygon();
+    if (polygon.empty())
+      continue;
+
+    lanelet::BasicPoint2d min_point = polygon.front();
+    lanelet::BasicPoint2d max_point = polygon.front();
+    for (const auto& point : polygon)
+    {
+      min_point = min_point.cwiseMin(point);
+      max_point = max_point.cwiseMax(point);
+    }
+    CrosswalkIndex::Box box(CrosswalkIndex::Point(min_point.x(), min_point.y()),
+                            CrosswalkIndex::Point(max_point.x(), max_point.y()));
+    boxes.emplace_back(box, index->lanelets.size());
+    index->lanelets.push_back(ll);
+    index->polygons.push_back(std::move(polygon));
+  }
+
+  // bulk loading (packing) gives a better tree than inserting one by one
+  index->rtree = decltype(index->rtree)(boxes.begin(), boxes.end());
+}
+
 // returns index of waypoint first crosswalk is detected (within 2 meters) from (if any -1 otherwise)
-int findClosestCrosswalk(const lanelet::ConstLanelets& crosswalks, const int closest_waypoint,
+int findClosestCrosswalk(const CrosswalkIndex& crosswalks, const int closest_waypoint,
                          const autoware_msgs::Lane& lane_msg, const int search_distance,
                          lanelet::ConstLanelets* closest_crosswalks, bool multiple_crosswalk_detection)
 {
@@ -126,39 +180,45 @@ int findClosestCrosswalk(const lanelet::ConstLanelets& crosswalks, const int clo
 
   double find_distance = 2.0;  // meter
 
+  std::vector<CrosswalkIndex::Value> candidates;
+  std::vector<bool> found(crosswalks.lanelets.size(), false);
+
   // find near crosswalk
   for (int wpi = closest_waypoint;
        wpi < closest_waypoint + search_distance && wpi < static_cast<int>(lane_msg.waypoints.size()); wpi++)
   {
     geometry_msgs::Point waypoint = lane_msg.waypoints[wpi].pose.pose.position;
     lanelet::BasicPoint2d wp2d(waypoint.x, waypoint.y);
-    waypoint.z = 0.0;
 
-    for (const auto& ll : crosswalks)
+    // crosswalks whose bounding box is within find_distance
+    CrosswalkIndex::Box search_box(CrosswalkIndex::Point(waypoint.x - find_distance, waypoint.y - find_distance),
+                                   CrosswalkIndex::Point(waypoint.x + find_distance, waypoint.y + find_distance));
+    candidates.clear();
+    crosswalks.rtree.query(boost::geometry::index::intersects(search_box), std::back_inserter(candidates));
+
+    // keep the order of the map as the result depends on it
+    std::sort(candidates.begin(), candidates.end(),
+              [](const CrosswalkIndex::Value& a, const CrosswalkIndex::Value& b) { return a.second < b.second; });
+
+    for (const auto& candidate : candidates)
     {
-      if (ll.hasAttribute(lanelet::AttributeName::Subtype))
+      const size_t id = candidate.second;
+      double d = lanelet::geometry::distance(crosswalks.polygons[id], wp2d);
+      if (d < find_distance)
       {
-        lanelet::Attribute attr = ll.attribute(lanelet::AttributeName::Subtype);
-
-        if (attr.value() == lanelet::AttributeValueString::Crosswalk)
+        if (!found[id])
         {
-          double d = lanelet::geometry::distance2d(ll, wp2d);
-          if (d < find_distance)
-          {
-            if (std::find(closest_crosswalks->begin(), closest_crosswalks->end(), ll) == closest_crosswalks->end())
-            {
-              closest_crosswalks->push_back(ll);
-            }
-            if (!multiple_crosswalk_detection)
-            {
-              wp_near_crosswalk = wpi;
-
-              return wp_near_crosswalk;
-            }
-            if (wp_near_crosswalk == -1)
-              wp_near_crosswalk = wpi;
-          }
+          found[id] = true;
+          closest_crosswalks->push_back(crosswalks.lanelets[id]);
         }
+        if (!multiple_crosswalk_detection)
+        {
+          wp_near_crosswalk = wpi;
+
+          return wp_near_crosswalk;
+        }
+        if (wp_near_crosswalk == -1)
+          wp_near_crosswalk = wpi;
       }
     }
   }
@@ -169,16 +229,19 @@ int findClosestCrosswalk(const lanelet::ConstLanelets& crosswalks, const int clo
 // obstacle detection for crosswalk
 // return EControl::STOP when there are lidar points in crosswalk
 // return EControl::Keep otherwise
-EControl crossWalkDetection(const pcl::PointCloud<pcl::PointXYZ>& points,
+EControl crossWalkDetection(const pcl::PointCloud<pcl::PointXYZ>& points, const PointsGrid& points_grid,
                             const lanelet::ConstLanelets& closest_crosswalks,
                             const geometry_msgs::PoseStamped& localizer_pose, const int points_threshold,
                             ObstaclePoints* obstacle_points)
 {
+  std::vector<int> point_indices;
   for (auto lli = closest_crosswalks.begin(); lli != closest_crosswalks.end(); lli++)
   {
     // get polygon in lidar frame
     lanelet::BasicPolygon2d transformed_poly2d;
     lanelet::BasicPolygon3d poly3d = lli->polygon3d().basicPolygon();
+    if (poly3d.empty())
+      continue;
 
     for (const auto& point : poly3d)
     {
@@ -189,9 +252,22 @@ EControl crossWalkDetection(const pcl::PointCloud<pcl::PointXYZ>& points,
       transformed_poly2d.push_back(transformed_point2d);
     }
 
+    // only the points around the bounding box of the polygon can be in it
+    lanelet::BasicPoint2d min_point = transformed_poly2d.front();
+    lanelet::BasicPoint2d max_point = transformed_poly2d.front();
+    for (const auto& point : transformed_poly2d)
+    {
+      min_point = min_point.cwiseMin(point);
+      max_point = max_point.cwiseMax(point);
+    }
+    const lanelet::BasicPoint2d center = (min_point + max_point) / 2.0;
+    const double search_radius = (max_point - min_point).norm() / 2.0 + 0.01;
+    points_grid.radiusSearch(center.x(), center.y(), -1.0, search_radius, &point_indices);
+
     int stop_count = 0;  // number of points in the detection area
-    for (const auto& p : points)
+    for (const int index : point_indices)
     {
+      const auto& p = points[index];
       lanelet::BasicPoint2d p2d(p.x, p.y);
       double distance = lanelet::geometry::distance(transformed_poly2d, p2d);
 
@@ -217,14 +293,16 @@ EControl crossWalkDetection(const pcl::PointCloud<pcl::PointXYZ>& points,
 }
 
 // same as velocity_set.cpp - except for no reference to vector maps or crosswalk
-int detectStopObstacle(const pcl::PointCloud<pcl::PointXYZ>& points, const int closest_waypoint, int detection_waypoint,
-                       const autoware_msgs::Lane& lane, const lanelet::ConstLanelets& closest_crosswalks,
+int detectStopObstacle(const pcl::PointCloud<pcl::PointXYZ>& points, const PointsGrid& points_grid,
+                       const int closest_waypoint, int detection_waypoint, const autoware_msgs::Lane& lane,
+                       const lanelet::ConstLanelets& closest_crosswalks,
                        double stop_range, double points_threshold, const geometry_msgs::PoseStamped& localizer_pose,
                        ObstaclePoints* obstacle_points, EObstacleType* obstacle_type,
                        const int wpidx_detection_result_by_other_nodes)
 {
   int stop_obstacle_waypoint = -1;
   *obstacle_type = EObstacleType::NONE;
+  std::vector<int> point_indices;
   // start search from the closest waypoint
   for (int i = closest_waypoint; i < closest_waypoint + STOP_SEARCH_DISTANCE; i++)
   {
@@ -245,8 +323,8 @@ int detectStopObstacle(const pcl::PointCloud<pcl::PointXYZ>& points, const int c
     if (i == detection_waypoint)
     {
       // found an obstacle in the cross walk
-      if (crossWalkDetection(points, closest_crosswalks, localizer_pose, points_threshold, obstacle_points) ==
-          EControl::STOP)
+      if (crossWalkDetection(points, points_grid, closest_crosswalks, localizer_pose, points_threshold,
+                             obstacle_points) == EControl::STOP)
       {
         stop_obstacle_waypoint = i;
         *obstacle_type = EObstacleType::ON_CROSSWALK;
@@ -259,22 +337,17 @@ int detectStopObstacle(const pcl::PointCloud<pcl::PointXYZ>& points, const int c
     tf::Vector3 tf_waypoint = point2vector(waypoint);
     tf_waypoint.setZ(0);
 
-    int stop_point_count = 0;
-    for (const auto& p : points)
+    // points within stop range around the waypoint
+    points_grid.radiusSearch(tf_waypoint.x(), tf_waypoint.y(), -1.0, stop_range, &point_indices);
+    int stop_point_count = point_indices.size();
+    for (const int index : point_indices)
     {
-      tf::Vector3 point_vector(p.x, p.y, 0);
-
-      // 2D distance between waypoint and points (obstacle)
-      double dt = tf::tfDistance(point_vector, tf_waypoint);
-      if (dt < stop_range)
-      {
-        stop_point_count++;
-        geometry_msgs::Point point_temp;
-        point_temp.x = p.x;
-        point_temp.y = p.y;
-        point_temp.z = p.z;
-        obstacle_points->setStopPoint(calcAbsoluteCoordinate(point_temp, localizer_pose.pose));
-      }
+      const auto& p = points[index];
+      geometry_msgs::Point point_temp;
+      point_temp.x = p.x;
+      point_temp.y = p.y;
+      point_temp.z = p.z;
+      obstacle_points->setStopPoint(calcAbsoluteCoordinate(point_temp, localizer_pose.pose));
     }
 
     // there is an obstacle if the number of points exceeded the threshold
@@ -294,12 +367,13 @@ int detectStopObstacle(const pcl::PointCloud<pcl::PointXYZ>& points, const int c
 }
 
 //  same as velocity_set.cpp - expect for no reference to vector maps
-int detectDecelerateObstacle(const pcl::PointCloud<pcl::PointXYZ>& points, const int closest_waypoint,
-                             const autoware_msgs::Lane& lane, const double stop_range, const double deceleration_range,
-                             const double points_threshold, const geometry_msgs::PoseStamped& localizer_pose,
-                             ObstaclePoints* obstacle_points)
+int detectDecelerateObstacle(const pcl::PointCloud<pcl::PointXYZ>& points, const PointsGrid& points_grid,
+                             const int closest_waypoint, const autoware_msgs::Lane& lane, const double stop_range,
+                             const double deceleration_range, const double points_threshold,
+                             const geometry_msgs::PoseStamped& localizer_pose, ObstaclePoints* obstacle_points)
 {
   int decelerate_obstacle_waypoint = -1;
+  std::vector<int> point_indices;
   // start search from the closest waypoint
   for (int i = closest_waypoint; i < closest_waypoint + DECELERATION_SEARCH_DISTANCE; i++)
   {
@@ -312,22 +386,18 @@ int detectDecelerateObstacle(const pcl::PointCloud<pcl::PointXYZ>& points, const
     tf::Vector3 tf_waypoint = point2vector(waypoint);
     tf_waypoint.setZ(0);
 
-    int decelerate_point_count = 0;
-    for (const auto& p : points)
+    // points within deceleration range around the waypoint
+    points_grid.radiusSearch(tf_waypoint.x(), tf_waypoint.y(), stop_range, stop_range + deceleration_range,
+                             &point_indices);
+    int decelerate_point_count = point_indices.size();
+    for (const int index : point_indices)
     {
-      tf::Vector3 point_vector(p.x, p.y, 0);
-
-      // 2D distance between waypoint and points (obstacle)
-      double dt = tf::tfDistance(point_vector, tf_waypoint);
-      if (dt > stop_range && dt < stop_range + deceleration_range)
-      {
-        decelerate_point_count++;
-        geometry_msgs::Point point_temp;
-        point_temp.x = p.x;
-        point_temp.y = p.y;
-        point_temp.z = p.z;
-        obstacle_points->setDeceleratePoint(calcAbsoluteCoordinate(point_temp, localizer_pose.pose));
-      }
+      const auto& p = points[index];
+      geometry_msgs::Point point_temp;
+      point_temp.x = p.x;
+      point_temp.y = p.y;
+      point_temp.z = p.z;
+      obstacle_points->setDeceleratePoint(calcAbsoluteCoordinate(point_temp, localizer_pose.pose));
     }
 
     // there is an obstacle if the number of points exceeded the threshold
@@ -360,8 +430,9 @@ EControl pointsDetection(const pcl::PointCloud<pcl::PointXYZ>& points, const int
 
   EObstacleType obstacle_type = EObstacleType::NONE;
   int stop_obstacle_waypoint =
-      detectStopObstacle(points, closest_waypoint, detection_waypoint, lane, closest_crosswalks, vs_info.getStopRange(),
-                         vs_info.getPointsThreshold(), vs_info.getLocalizerPose(), obstacle_points, &obstacle_type,
+      detectStopObstacle(points, vs_info.getPointsGrid(), closest_waypoint, detection_waypoint, lane,
+                         closest_crosswalks, vs_info.getStopRange(), vs_info.getPointsThreshold(),
+                         vs_info.getLocalizerPose(), obstacle_points, &obstacle_type,
                          vs_info.getDetectionResultByOtherNodes());
 
   // skip searching deceleration range
@@ -379,8 +450,9 @@ EControl pointsDetection(const pcl::PointCloud<pcl::PointXYZ>& points, const int
   }
 
   int decelerate_obstacle_waypoint =
-      detectDecelerateObstacle(points, closest_waypoint, lane, vs_info.getStopRange(), vs_info.getDecelerationRange(),
-                               vs_info.getPointsThreshold(), vs_info.getLocalizerPose(), obstacle_points);
+      detectDecelerateObstacle(points, vs_info.getPointsGrid(), closest_waypoint, lane, vs_info.getStopRange(),
+                               vs_info.getDecelerationRange(), vs_info.getPointsThreshold(),
+                               vs_info.getLocalizerPose(), obstacle_points);
 
   // stop obstacle was not found
   if (stop_obstacle_waypoint < 0)
@@ -532,7 +604,7 @@ void displayDetectionRange(const autoware_msgs::Lane& lane, const lanelet::Const
 
 // same as velocity_set.cpp - except for no reference to vector maps
 EControl obstacleDetection(int closest_waypoint, int detection_waypoint, const autoware_msgs::Lane& lane,
-                           const lanelet::ConstLanelets& closest_crosswalks, const VelocitySetInfo vs_info,
+                           const lanelet::ConstLanelets& closest_crosswalks, const VelocitySetInfo& vs_info,
                            const ros::Publisher& detection_range_pub, const ros::Publisher& obstacle_pub,
                            int* obstacle_waypoint)
 {
@@ -621,7 +693,7 @@ void binMapCallback(const autoware_lanelet2_msgs::MapBin& msg)
   lanelet::utils::conversion::fromBinMsg(msg, g_lanelet_map);
   g_loaded_lanelet_map = true;
   lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(g_lanelet_map);
-  g_crosswalk_lanelets = lanelet::utils::query::crosswalkLanelets(all_lanelets);
+  buildCrosswalkIndex(lanelet::utils::query::crosswalkLanelets(all_lanelets), &g_crosswalk_index);
   ROS_INFO("velocity_set_lanelet2: lanelet map loaded\n");
 }
 
@@ -698,7 +770,7 @@ int main(int argc, char** argv)
         ROS_WARN("use_crosswalk_detection is true, but lanelet map is not loaded!");
       }
       detection_waypoint =
-          findClosestCrosswalk(g_crosswalk_lanelets, closest_waypoint, vs_path.getPrevWaypoints(), STOP_SEARCH_DISTANCE,
+          findClosestCrosswalk(g_crosswalk_index, closest_waypoint, vs_path.getPrevWaypoints(), STOP_SEARCH_DISTANCE,
                                &closest_crosswalks, enable_multiple_crosswalk_detection);
     }
 
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ros/ros.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "waypoint_planner/velocity_set/libvelocity_set.h"
+
+class PointsGridTestSuite : public ::testing::Test
+{
+public:
+  PointsGridTestSuite() {}
+  ~PointsGridTestSuite() {}
+
+  // loop over all points, as velocity_set did before the grid
+  std::vector<int> bruteForceSearch(const pcl::PointCloud<pcl::PointXYZ>& points, const double x, const double y,
+                                    const double min_range, const double max_range)
+  {
+    std::vector<int> indices;
+    tf::Vector3 waypoint(x, y, 0);
+    for (size_t i = 0; i < points.size(); i++)
+    {
+      tf::Vector3 point_vector(points[i].x, points[i].y, 0);
+      double dt = tf::tfDistance(point_vector, waypoint);
+      if (dt > min_range && dt < max_range)
+        indices.push_back(i);
+    }
+    return indices;
+  }
+
+  void expectSameAsBruteForce(const pcl::PointCloud<pcl::PointXYZ>& points, const double cell_size,
+                              std::mt19937* gen)
+  {
+    PointsGrid grid;
+    grid.build(points, cell_size);
+
+    std::uniform_real_distribution<double> query(-60.0, 60.0);
+    std::uniform_real_distribution<double> range(0.0, 15.0);
+    std::vector<int> indices;
+    for (int i = 0; i < 200; i++)
+    {
+      const double x = query(*gen);
+      const double y = query(*gen);
+      const double min_range = (i % 2 == 0) ? -1.0 : range(*gen);
+      const double max_range = min_range + range(*gen);
+      grid.radiusSearch(x, y, min_range, max_range, &indices);
+      ASSERT_EQ(bruteForceSearch(points, x, y, min_range, max_range), indices)
+          << "x = " << x << ", y = " << y << ", range = (" << min_range << ", " << max_range << ")";
+    }
+  }
+};
+
+TEST_F(PointsGridTestSuite, TestRandomPoints)
+{
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> coord(-50.0, 50.0);
+  for (const double cell_size : { 0.5, 3.0, 20.0 })
+  {
+    pcl::PointCloud<pcl::PointXYZ> points;
+    for (int i = 0; i < 3000; i++)
+      points.push_back(pcl::PointXYZ(coord(gen), coord(gen), 0.0));
+    expectSameAsBruteForce(points, cell_size, &gen);
+  }
+}
+
+TEST_F(PointsGridTestSuite, TestNonFinitePoints)
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float inf = std::numeric_limits<float>::infinity();
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<float> coord(-50.0, 50.0);
+
+  pcl::PointCloud<pcl::PointXYZ> points;
+  points.push_back(pcl::PointXYZ(nan, nan, 0.0));
+  for (int i = 0; i < 1000; i++)
+  {
+    points.push_back(pcl::PointXYZ(coord(gen), coord(gen), 0.0));
+    if (i % 100 == 0)
+    {
+      points.push_back(pcl::PointXYZ(coord(gen), nan, 0.0));
+      points.push_back(pcl::PointXYZ(-inf, coord(gen), 0.0));
+    }
+  }
+  expectSameAsBruteForce(points, 3.0, &gen);
+
+  // nan query
+  PointsGrid grid;
+  grid.build(points, 3.0);
+  std::vector<int> indices;
+  grid.radiusSearch(nan, 0.0, -1.0, 10.0, &indices);
+  ASSERT_TRUE(indices.empty());
+}
+
+TEST_F(PointsGridTestSuite, TestFarOutliers)
+{
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<float> coord(-50.0, 50.0);
+
+  pcl::PointCloud<pcl::PointXYZ> points;
+  for (int i = 0; i < 1000; i++)
+    points.push_back(pcl::PointXYZ(coord(gen), coord(gen), 0.0));
+  points.push_back(pcl::PointXYZ(-1.0e30, 1.0e30, 0.0));
+  points.push_back(pcl::PointXYZ(3.0e38, -3.0e38, 0.0));
+  expectSameAsBruteForce(points, 1.0, &gen);
+}
+
+TEST_F(PointsGridTestSuite, TestEmptyPoints)
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  PointsGrid grid;
+  std::vector<int> indices;
+
+  pcl::PointCloud<pcl::PointXYZ> points;
+  grid.build(points, 3.0);
+  grid.radiusSearch(0.0, 0.0, -1.0, 10.0, &indices);
+  ASSERT_TRUE(indices.empty());
+
+  // no finite point
+  points.push_back(pcl::PointXYZ(nan, 0.0, 0.0));
+  points.push_back(pcl::PointXYZ(0.0, nan, 0.0));
+  grid.build(points, 3.0);
+  grid.radiusSearch(0.0, 0.0, -1.0, 10.0, &indices);
+  ASSERT_TRUE(indices.empty());
+}
+
+/* benchmark, not run by default : --gtest_also_run_disabled_tests --gtest_filter=*Benchmark* */
+TEST_F(PointsGridTestSuite, DISABLED_BenchmarkRadiusSearch)
+{
+  // 30000 points of a cloud, queried at 100 waypoints with the default detection_range of velocity_set
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<float> coord(-50.0, 50.0);
+  pcl::PointCloud<pcl::PointXYZ> points;
+  for (int i = 0; i < 30000; i++)
+    points.push_back(pcl::PointXYZ(coord(gen), coord(gen), 0.0));
+
+  const int repeat = 10;
+  std::vector<int> indices;
+  size_t grid_count = 0;
+  size_t brute_force_count = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeat; r++)
+  {
+    PointsGrid grid;
+    grid.build(points, 1.3);
+    for (int i = 0; i < 100; i++)
+    {
+      grid.radiusSearch(-50.0 + i, 0.0, -1.0, 1.3, &indices);
+      grid_count += indices.size();
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  const double grid_time = std::chrono::duration<double, std::milli>(end - start).count() / repeat;
+
+  start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeat; r++)
+  {
+    for (int i = 0; i < 100; i++)
+      brute_force_count += bruteForceSearch(points, -50.0 + i, 0.0, -1.0, 1.3).size();
+  }
+  end = std::chrono::steady_clock::now();
+  const double brute_force_time = std::chrono::duration<double, std::milli>(end - start).count() / repeat;
+
+  ASSERT_EQ(brute_force_count, grid_count);
+  std::cout << "build and search " << grid_time << " [ms], brute force " << brute_force_time << " [ms]"
+            << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "TestNode");
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2019 Autoware Foundation. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ros/ros.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "waypoint_planner/velocity_set/velocity_set_path.h"
+
+class VelocitySetPathTestSuite : public ::testing::Test
+{
+public:
+  VelocitySetPathTestSuite() {}
+  ~VelocitySetPathTestSuite() {}
+
+  // random walk with steps of 0.1 to 2.0 m
+  autoware_msgs::LanePtr createRandomLane(const int size, std::mt19937* gen)
+  {
+    std::uniform_real_distribution<double> step(0.1, 2.0);
+    std::uniform_real_distribution<double> turn(-0.3, 0.3);
+    autoware_msgs::LanePtr lane(new autoware_msgs::Lane);
+    double x = 0.0;
+    double y = 0.0;
+    double yaw = 0.0;
+    for (int i = 0; i < size; i++)
+    {
+      autoware_msgs::Waypoint wp;
+      wp.pose.pose.position.x = x;
+      wp.pose.pose.position.y = y;
+      wp.pose.pose.position.z = 0.1 * i;
+      lane->waypoints.push_back(wp);
+      const double d = step(*gen);
+      yaw += turn(*gen);
+      x += d * std::cos(yaw);
+      y += d * std::sin(yaw);
+    }
+    return lane;
+  }
+
+  // sum of the intervals between begin and end, as calcInterval did before the arc length table
+  double sumIntervals(const autoware_msgs::Lane& lane, const int begin, const int end)
+  {
+    if (begin < 0 || begin >= static_cast<int>(lane.waypoints.size()) || end < 0 ||
+        end >= static_cast<int>(lane.waypoints.size()) || begin >= end)
+      return 0.0;
+
+    double dist_sum = 0.0;
+    for (int i = begin; i < end; i++)
+    {
+      tf::Vector3 v1(lane.waypoints[i].pose.pose.position.x, lane.waypoints[i].pose.pose.position.y, 0);
+      tf::Vector3 v2(lane.waypoints[i + 1].pose.pose.position.x, lane.waypoints[i + 1].pose.pose.position.y, 0);
+      dist_sum += tf::tfDistance(v1, v2);
+    }
+    return dist_sum;
+  }
+};
+
+TEST_F(VelocitySetPathTestSuite, TestCalcInterval)
+{
+  std::mt19937 gen(0);
+  VelocitySetPath path;
+
+  // every pair of a short lane
+  autoware_msgs::LanePtr lane = createRandomLane(100, &gen);
+  path.waypointsCallback(lane);
+  for (int begin = 0; begin < 100; begin++)
+  {
+    for (int end = begin + 1; end < 100; end++)
+    {
+      ASSERT_NEAR(sumIntervals(*lane, begin, end), path.calcInterval(begin, end), 1.0e-9)
+          << "begin = " << begin << ", end = " << end;
+    }
+  }
+
+  // random pairs of a long lane, set after the short one
+  lane = createRandomLane(5000, &gen);
+  path.waypointsCallback(lane);
+  std::uniform_int_distribution<int> index(0, 4999);
+  for (int i = 0; i < 1000; i++)
+  {
+    int begin = index(gen);
+    int end = index(gen);
+    if (begin > end)
+      std::swap(begin, end);
+    const double expected = sumIntervals(*lane, begin, end);
+    ASSERT_NEAR(expected, path.calcInterval(begin, end), 1.0e-9 * std::max(expected, 1.0))
+        << "begin = " << begin << ", end = " << end;
+  }
+}
+
+TEST_F(VelocitySetPathTestSuite, TestCalcIntervalInvalidRange)
+{
+  std::mt19937 gen(1);
+  VelocitySetPath path;
+
+  // no lane yet
+  ASSERT_EQ(0.0, path.calcInterval(0, 1));
+
+  // empty lane
+  path.waypointsCallback(autoware_msgs::LanePtr(new autoware_msgs::Lane));
+  ASSERT_EQ(0.0, path.calcInterval(0, 0));
+  ASSERT_EQ(0.0, path.calcInterval(0, 1));
+
+  // single waypoint
+  path.waypointsCallback(createRandomLane(1, &gen));
+  ASSERT_EQ(0.0, path.calcInterval(0, 0));
+  ASSERT_EQ(0.0, path.calcInterval(0, 1));
+
+  autoware_msgs::LanePtr lane = createRandomLane(10, &gen);
+  path.waypointsCallback(lane);
+  // begin >= end
+  ASSERT_EQ(0.0, path.calcInterval(5, 5));
+  ASSERT_EQ(0.0, path.calcInterval(6, 5));
+  // out of range
+  ASSERT_EQ(0.0, path.calcInterval(-1, 5));
+  ASSERT_EQ(0.0, path.calcInterval(5, 10));
+  ASSERT_EQ(0.0, path.calcInterval(10, 11));
+  // boundaries are valid
+  ASSERT_NEAR(sumIntervals(*lane, 0, 9), path.calcInterval(0, 9), 1.0e-9);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  ros::init(argc, argv, "TestNode");
+  return RUN_ALL_TESTS();
+}